@@ -122,6 +122,12 @@ cluster()
     ./ci/blackbox.sh --driver=simx --cores=4 --clusters=2 --l2cache --app=diverge --args="-n1"
     ./ci/blackbox.sh --driver=simx --cores=4 --clusters=4 --l2cache --l3cache --app=diverge --args="-n1"
 
+    # uneven distribution across cores (11 blocks, 62 tasks on 4 cores)
+    ./ci/blackbox.sh --driver=simx --cores=4 --app=grid3d --args="-x44 -y4 -z1"
+    ./ci/blackbox.sh --driver=rtlsim --cores=4 --app=grid3d --args="-x44 -y4 -z1"
+    ./ci/blackbox.sh --driver=simx --cores=4 --app=inlinespawn --args="-t62"
+    ./ci/blackbox.sh --driver=rtlsim --cores=4 --app=inlinespawn --args="-t62"
+
     echo "clustering tests done!"
 }
 
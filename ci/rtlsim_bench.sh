@@ -0,0 +1,157 @@
+#!/bin/sh
+
+# Copyright © 2019-2023
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Compares rtlsim simulation speed (simulated cycles per second of host time)
+# of the working tree against a baseline revision, for each build variant.
+
+show_usage()
+{
+    echo "Vortex RTLSim Baseline Benchmark v1.0"
+    echo "Usage: $0 [[--app=#app] [--args=#args] [--baseline=#rev] [--builds=#list] [--configs=#configs] [--help]]"
+}
+
+show_help()
+{
+    show_usage
+    echo "  where"
+    echo "--app: any subfolder test under regression or opencl"
+    echo "--baseline: git revision to compare against (default: HEAD~1)"
+    echo "--builds: space-separated list of build variants, each a comma-separated list of make variables (default: \"default SIM_THREADS=4 CHECKPOINT=1\")"
+    echo "--configs: hardware configuration passed to both builds (default: none)"
+}
+
+SCRIPT_DIR=$(dirname "$0")
+ROOT_DIR=$(cd "$SCRIPT_DIR/.." && pwd)
+
+APP=demo
+ARGS=
+BASELINE=HEAD~1
+BUILDS="default SIM_THREADS=4 CHECKPOINT=1"
+CONFIGS=
+
+for i in "$@"
+do
+case $i in
+    --app=*)
+        APP=${i#*=}
+        shift
+        ;;
+    --args=*)
+        ARGS=${i#*=}
+        shift
+        ;;
+    --baseline=*)
+        BASELINE=${i#*=}
+        shift
+        ;;
+    --builds=*)
+        BUILDS=${i#*=}
+        shift
+        ;;
+    --configs=*)
+        CONFIGS=${i#*=}
+        shift
+        ;;
+    --help)
+        show_help
+        exit 0
+        ;;
+    *)
+        show_usage
+        exit -1
+        ;;
+esac
+done
+
+if [ -d "$ROOT_DIR/tests/opencl/$APP" ];
+then
+    APP_PATH=$ROOT_DIR/tests/opencl/$APP
+elif [ -d "$ROOT_DIR/tests/regression/$APP" ];
+then
+    APP_PATH=$ROOT_DIR/tests/regression/$APP
+else
+    echo "Application folder not found: $APP"
+    exit -1
+fi
+
+TEMPDIR=$(mktemp -d)
+trap "git -C $ROOT_DIR worktree remove --force $TEMPDIR/baseline > /dev/null 2>&1; rm -rf $TEMPDIR" EXIT
+LOGFILE=$TEMPDIR/run.log
+
+# check out the baseline next to the working tree
+if ! git -C $ROOT_DIR worktree add --detach $TEMPDIR/baseline $BASELINE > /dev/null 2>&1
+then
+    echo "Invalid baseline revision: $BASELINE"
+    exit -1
+fi
+
+# ensure config update
+make -C $ROOT_DIR/hw config > /dev/null
+make -C $TEMPDIR/baseline/hw config > /dev/null
+
+# ensure the stub driver is present
+make -C $ROOT_DIR/runtime/stub > /dev/null
+
+# build the application once, so that its compile time is not measured
+make -C $APP_PATH > /dev/null || exit -1
+
+printf "%-28s %-10s %-12s %-10s %-14s\n" "build" "tree" "cycles" "time(s)" "cycles/sec"
+
+for build in $BUILDS
+do
+    if [ "$build" = "default" ]
+    then
+        build_vars=
+    else
+        build_vars=$(echo $build | tr ',' ' ')
+    fi
+
+    for tree in baseline current
+    do
+        if [ "$tree" = "baseline" ]
+        then
+            tree_dir=$TEMPDIR/baseline
+        else
+            tree_dir=$ROOT_DIR
+        fi
+
+        # each variant requires a clean model build
+        rm -rf "$TEMPDIR/rtlsim"
+        mkdir -p "$TEMPDIR/rtlsim"
+        if ! env $build_vars DESTDIR="$TEMPDIR/rtlsim" CONFIGS="$CONFIGS" make -C $tree_dir/runtime/rtlsim > /dev/null 2>&1
+        then
+            echo "build failed: build=$build, tree=$tree"
+            exit -1
+        fi
+
+        start=$(date +%s.%N)
+        VORTEX_RT_PATH=$TEMPDIR OPTS=$ARGS make -C $APP_PATH run-rtlsim > $LOGFILE 2>&1
+        status=$?
+        end=$(date +%s.%N)
+
+        if [ $status -ne 0 ]
+        then
+            echo "run failed: build=$build, tree=$tree (see below)"
+            cat $LOGFILE
+            exit $status
+        fi
+
+        cycles=$(sed -n 's/^PERF: instrs=[0-9]*, cycles=\([0-9]*\).*/\1/p' $LOGFILE | tail -n 1)
+        awk -v b="$build" -v t="$tree" -v n="$cycles" -v s="$start" -v e="$end" \
+            'BEGIN { d = e - s; printf "%-28s %-10s %-12s %-10.2f %-14.0f\n", b, t, n, d, (d > 0) ? n / d : 0 }'
+    done
+done
+
+exit 0
@@ -0,0 +1,113 @@
+#!/bin/sh
+
+# Copyright © 2019-2023
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Checks that rtlsim idle-cycle skipping is exact: runs an application on a
+# SKIP_IDLE build with skipping disabled then enabled, and compares the MPM
+# counters dumped at device close.
+
+show_usage()
+{
+    echo "Vortex RTLSim Idle Skipping Check v1.0"
+    echo "Usage: $0 [[--app=#app] [--args=#args] [--cores=#n] [--help]]"
+}
+
+SCRIPT_DIR=$(dirname "$0")
+ROOT_DIR=$SCRIPT_DIR/..
+
+APP=demo
+ARGS=
+CORES=1
+
+for i in "$@"
+do
+case $i in
+    --app=*)
+        APP=${i#*=}
+        shift
+        ;;
+    --args=*)
+        ARGS=${i#*=}
+        shift
+        ;;
+    --cores=*)
+        CORES=${i#*=}
+        shift
+        ;;
+    --help)
+        show_usage
+        exit 0
+        ;;
+    *)
+        show_usage
+        exit -1
+        ;;
+esac
+done
+
+if [ -d "$ROOT_DIR/tests/opencl/$APP" ];
+then
+    APP_PATH=$ROOT_DIR/tests/opencl/$APP
+elif [ -d "$ROOT_DIR/tests/regression/$APP" ];
+then
+    APP_PATH=$ROOT_DIR/tests/regression/$APP
+else
+    echo "Application folder not found: $APP"
+    exit -1
+fi
+
+# ensure config update
+make -C $ROOT_DIR/hw config > /dev/null
+
+# ensure the stub driver is present
+make -C $ROOT_DIR/runtime/stub > /dev/null
+
+make -C $APP_PATH > /dev/null || exit -1
+
+TEMPDIR=$(mktemp -d)
+trap "rm -rf $TEMPDIR" EXIT
+mkdir -p "$TEMPDIR/rtlsim"
+
+if ! DESTDIR="$TEMPDIR/rtlsim" SKIP_IDLE=1 CONFIGS="-DNUM_CORES=$CORES" make -C $ROOT_DIR/runtime/rtlsim > /dev/null 2>&1
+then
+    echo "build failed"
+    exit -1
+fi
+
+for skip in 0 1
+do
+    start=$(date +%s.%N)
+    VORTEX_SKIP_IDLE=$skip VORTEX_RT_PATH=$TEMPDIR OPTS=$ARGS make -C $APP_PATH run-rtlsim > $TEMPDIR/run$skip.log 2>&1
+    status=$?
+    end=$(date +%s.%N)
+    if [ $status -ne 0 ]
+    then
+        echo "run failed: VORTEX_SKIP_IDLE=$skip"
+        cat $TEMPDIR/run$skip.log
+        exit $status
+    fi
+    grep "^PERF:" $TEMPDIR/run$skip.log > $TEMPDIR/perf$skip.log
+    awk -v k="$skip" -v s="$start" -v e="$end" 'BEGIN { printf "VORTEX_SKIP_IDLE=%s: %.2f s\n", k, e - s }'
+done
+
+grep "skipped idle cycles" $TEMPDIR/run1.log
+
+if ! diff $TEMPDIR/perf0.log $TEMPDIR/perf1.log
+then
+    echo "FAILED: counters differ with idle skipping"
+    exit 1
+fi
+
+echo "PASSED: counters match"
+exit 0
@@ -0,0 +1,129 @@
+#!/bin/sh
+
+# Copyright © 2019-2023
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Measures rtlsim simulation speed (simulated cycles per second of host time)
+# for each core count and Verilator thread count combination.
+
+show_usage()
+{
+    echo "Vortex RTLSim Threading Benchmark v1.0"
+    echo "Usage: $0 [[--app=#app] [--args=#args] [--cores=#list] [--sim-threads=#list] [--help]]"
+}
+
+show_help()
+{
+    show_usage
+    echo "  where"
+    echo "--app: any subfolder test under regression or opencl"
+    echo "--cores: space-separated list of core counts (default: \"1 2 4 8 16\")"
+    echo "--sim-threads: space-separated list of Verilator thread counts (default: \"1 2 4 8\")"
+}
+
+SCRIPT_DIR=$(dirname "$0")
+ROOT_DIR=$SCRIPT_DIR/..
+
+APP=demo
+ARGS=
+CORES_LIST="1 2 4 8 16"
+THREADS_LIST="1 2 4 8"
+
+for i in "$@"
+do
+case $i in
+    --app=*)
+        APP=${i#*=}
+        shift
+        ;;
+    --args=*)
+        ARGS=${i#*=}
+        shift
+        ;;
+    --cores=*)
+        CORES_LIST=${i#*=}
+        shift
+        ;;
+    --sim-threads=*)
+        THREADS_LIST=${i#*=}
+        shift
+        ;;
+    --help)
+        show_help
+        exit 0
+        ;;
+    *)
+        show_usage
+        exit -1
+        ;;
+esac
+done
+
+if [ -d "$ROOT_DIR/tests/opencl/$APP" ];
+then
+    APP_PATH=$ROOT_DIR/tests/opencl/$APP
+elif [ -d "$ROOT_DIR/tests/regression/$APP" ];
+then
+    APP_PATH=$ROOT_DIR/tests/regression/$APP
+else
+    echo "Application folder not found: $APP"
+    exit -1
+fi
+
+# ensure config update
+make -C $ROOT_DIR/hw config > /dev/null
+
+# ensure the stub driver is present
+make -C $ROOT_DIR/runtime/stub > /dev/null
+
+# build the application once, so that its compile time is not measured
+make -C $APP_PATH > /dev/null || exit -1
+
+TEMPDIR=$(mktemp -d)
+trap "rm -rf $TEMPDIR" EXIT
+LOGFILE=$TEMPDIR/run.log
+
+printf "%-8s %-8s %-12s %-10s %-14s\n" "cores" "threads" "cycles" "time(s)" "cycles/sec"
+
+for cores in $CORES_LIST
+do
+    for threads in $THREADS_LIST
+    do
+        # switching thread counts requires a clean model build
+        rm -rf "$TEMPDIR/rtlsim"
+        mkdir -p "$TEMPDIR/rtlsim"
+        if ! DESTDIR="$TEMPDIR/rtlsim" SIM_THREADS=$threads CONFIGS="-DNUM_CORES=$cores" make -C $ROOT_DIR/runtime/rtlsim > /dev/null 2>&1
+        then
+            echo "build failed: cores=$cores, threads=$threads"
+            exit -1
+        fi
+
+        start=$(date +%s.%N)
+        VORTEX_RT_PATH=$TEMPDIR OPTS=$ARGS make -C $APP_PATH run-rtlsim > $LOGFILE 2>&1
+        status=$?
+        end=$(date +%s.%N)
+
+        if [ $status -ne 0 ]
+        then
+            echo "run failed: cores=$cores, threads=$threads (see below)"
+            cat $LOGFILE
+            exit $status
+        fi
+
+        cycles=$(sed -n 's/^PERF: instrs=[0-9]*, cycles=\([0-9]*\).*/\1/p' $LOGFILE | tail -n 1)
+        awk -v c="$cores" -v t="$threads" -v n="$cycles" -v s="$start" -v e="$end" \
+            'BEGIN { d = e - s; printf "%-8s %-8s %-12s %-10.2f %-14.0f\n", c, t, n, d, (d > 0) ? n / d : 0 }'
+    done
+done
+
+exit 0
@@ -53,6 +53,10 @@ extern "C" {
   void dpi_fmax(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags);
 }
 
+// softfloat keeps the rounding mode and exception flags in globals, so calls
+// from the threads of a multithreaded Verilator model are serialized
+static std::mutex softfloat_mutex;
+
 inline uint64_t nan_box(uint32_t value) {
 #ifdef FPU_RV64F
   return value | 0xffffffff00000000;
@@ -80,6 +84,7 @@ inline int64_t check_boxing(int64_t a) {
 void dpi_fadd(bool enable, int dst_fmt, int64_t a, int64_t b, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) {
     *result = rv_fadd_d(a, b, (*frm & 0x7), fflags);
   } else {
@@ -90,6 +95,7 @@ void dpi_fadd(bool enable, int dst_fmt, int64_t a, int64_t b, const svBitVecVal*
 void dpi_fsub(bool enable, int dst_fmt, int64_t a, int64_t b, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) {
     *result = rv_fsub_d(a, b, (*frm & 0x7), fflags);
   } else {
@@ -100,6 +106,7 @@ void dpi_fsub(bool enable, int dst_fmt, int64_t a, int64_t b, const svBitVecVal*
 void dpi_fmul(bool enable, int dst_fmt, int64_t a, int64_t b, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fmul_d(a, b, (*frm & 0x7), fflags); 
   } else {
@@ -110,6 +117,7 @@ void dpi_fmul(bool enable, int dst_fmt, int64_t a, int64_t b, const svBitVecVal*
 void dpi_fmadd(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t c, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fmadd_d(a, b, c, (*frm & 0x7), fflags);
   } else {
@@ -120,6 +128,7 @@ void dpi_fmadd(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t c, const
 void dpi_fmsub(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t c, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fmsub_d(a, b, c, (*frm & 0x7), fflags);
   } else {
@@ -130,6 +139,7 @@ void dpi_fmsub(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t c, const
 void dpi_fnmadd(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t c, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fnmadd_d(a, b, c, (*frm & 0x7), fflags);
   } else {
@@ -140,6 +150,7 @@ void dpi_fnmadd(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t c, const
 void dpi_fnmsub(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t c, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fnmsub_d(a, b, c, (*frm & 0x7), fflags);
   } else {
@@ -150,6 +161,7 @@ void dpi_fnmsub(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t c, const
 void dpi_fdiv(bool enable, int dst_fmt, int64_t a, int64_t b, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fdiv_d(a, b, (*frm & 0x7), fflags); 
   } else {
@@ -160,6 +172,7 @@ void dpi_fdiv(bool enable, int dst_fmt, int64_t a, int64_t b, const svBitVecVal*
 void dpi_fsqrt(bool enable, int dst_fmt, int64_t a, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fsqrt_d(a, (*frm & 0x7), fflags); 
   } else {
@@ -170,6 +183,7 @@ void dpi_fsqrt(bool enable, int dst_fmt, int64_t a, const svBitVecVal* frm, int6
 void dpi_ftoi(bool enable, int dst_fmt, int src_fmt, int64_t a, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) {
     if (src_fmt) { 
       *result = rv_ftol_d(a, (*frm & 0x7), fflags);
@@ -188,6 +202,7 @@ void dpi_ftoi(bool enable, int dst_fmt, int src_fmt, int64_t a, const svBitVecVa
 void dpi_ftou(bool enable, int dst_fmt, int src_fmt, int64_t a, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) {
     if (src_fmt) { 
       *result = rv_ftolu_d(a, (*frm & 0x7), fflags);
@@ -206,6 +221,7 @@ void dpi_ftou(bool enable, int dst_fmt, int src_fmt, int64_t a, const svBitVecVa
 void dpi_itof(bool enable, int dst_fmt, int src_fmt, int64_t a, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) {
     if (src_fmt) { 
       *result = rv_ltof_d(a, (*frm & 0x7), fflags);
@@ -224,6 +240,7 @@ void dpi_itof(bool enable, int dst_fmt, int src_fmt, int64_t a, const svBitVecVa
 void dpi_utof(bool enable, int dst_fmt, int src_fmt, int64_t a, const svBitVecVal* frm, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) {
     if (src_fmt) { 
       *result = rv_lutof_d(a, (*frm & 0x7), fflags);
@@ -242,6 +259,7 @@ void dpi_utof(bool enable, int dst_fmt, int src_fmt, int64_t a, const svBitVecVa
 void dpi_f2f(bool enable, int dst_fmt, int64_t a, int64_t* result) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) {
     *result = rv_ftod((int32_t)check_boxing(a));
   } else {
@@ -252,6 +270,7 @@ void dpi_f2f(bool enable, int dst_fmt, int64_t a, int64_t* result) {
 void dpi_fclss(bool enable, int dst_fmt, int64_t a, int64_t* result) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fclss_d(a); 
   } else { 
@@ -262,6 +281,7 @@ void dpi_fclss(bool enable, int dst_fmt, int64_t a, int64_t* result) {
 void dpi_fsgnj(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fsgnj_d(a, b); 
   } else {
@@ -272,6 +292,7 @@ void dpi_fsgnj(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result)
 void dpi_fsgnjn(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fsgnjn_d(a, b); 
   } else {
@@ -282,6 +303,7 @@ void dpi_fsgnjn(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result)
 void dpi_fsgnjx(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fsgnjx_d(a, b); 
   } else {
@@ -292,6 +314,7 @@ void dpi_fsgnjx(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result)
 void dpi_flt(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) {
     *result = rv_flt_d(a, b, fflags); 
   } else {
@@ -302,6 +325,7 @@ void dpi_flt(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, sv
 void dpi_fle(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fle_d(a, b, fflags); 
   } else {
@@ -312,6 +336,7 @@ void dpi_fle(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, sv
 void dpi_feq(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_feq_d(a, b, fflags); 
   } else {
@@ -322,6 +347,7 @@ void dpi_feq(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, sv
 void dpi_fmin(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fmin_d(a, b, fflags); 
   } else {
@@ -332,6 +358,7 @@ void dpi_fmin(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, s
 void dpi_fmax(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags) {
   if (!enable) 
     return;
+  std::lock_guard<std::mutex> lock(softfloat_mutex);
   if (dst_fmt) { 
     *result = rv_fmax_d(a, b, fflags); 
   } else {
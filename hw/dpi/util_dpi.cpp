@@ -12,9 +12,11 @@
 // limitations under the License.
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <unordered_map>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <iostream>
 
@@ -49,8 +51,13 @@ extern "C" {
   void dpi_trace(int level, const char* format, ...);
   void dpi_trace_start();
   void dpi_trace_stop();
+  void dpi_trace_pc(uint64_t PC);
 
   uint64_t dpi_uuid_gen(bool reset, int wid, uint64_t PC);
+
+  void dpi_idle_report(int core_id, int state);
+  uint64_t dpi_idle_skipped(int core_id);
+  void dpi_idle_busy(bool busy);
 }
 
 bool sim_trace_enabled();
@@ -88,22 +95,24 @@ private:
   unsigned depth_;
 };
 
+// DPI calls may come from the worker threads of a multithreaded model;
+// instances are heap allocated so references stay valid as the table grows
 class Instances {
 public:
   ShiftRegister& get(int inst) {
-    return instances_.at(inst);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return *instances_.at(inst);
   }
 
   int allocate() {
-    mutex_.lock();
+    std::lock_guard<std::mutex> lock(mutex_);
     int inst = instances_.size();
-    instances_.resize(inst + 1);
-    mutex_.unlock();
+    instances_.emplace_back(new ShiftRegister());
     return inst;
   }
 
 private:
-  std::vector<ShiftRegister> instances_;
+  std::vector<std::unique_ptr<ShiftRegister>> instances_;
   std::mutex mutex_;
 };
 
@@ -188,11 +197,15 @@ void dpi_idiv(bool enable, bool is_signed, iword_t a, iword_t b, iword_t* quotie
 
 ///////////////////////////////////////////////////////////////////////////////
 
+std::mutex g_trace_mutex;
+
 void dpi_trace(int level, const char* format, ...) {
   if (level > DEBUG_LEVEL)
     return;
   if (!sim_trace_enabled())
     return;
+  // keep lines from concurrent model threads from interleaving
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
   va_list va;
 	va_start(va, format);
 	vprintf(format, va);
@@ -207,11 +220,30 @@ void dpi_trace_stop() {
   sim_trace_enable(false);
 }
 
+static uint64_t trace_pc_env(const char* name) {
+  auto value = getenv(name);
+  return value ? strtoull(value, nullptr, 0) : -1ull;
+}
+
+// start/stop tracing when an instruction at VORTEX_TRACE_PC/VORTEX_TRACE_PC_STOP is scheduled
+void dpi_trace_pc(uint64_t PC) {
+  static const uint64_t start_pc = trace_pc_env("VORTEX_TRACE_PC");
+  static const uint64_t stop_pc  = trace_pc_env("VORTEX_TRACE_PC_STOP");
+  if (PC == start_pc) {
+    sim_trace_enable(true);
+  }
+  if (PC == stop_pc) {
+    sim_trace_enable(false);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 std::unordered_map<uint32_t, std::shared_ptr<vortex::UUIDGenerator>> g_uuid_gens;
+std::mutex g_uuid_mutex;
 
 uint64_t dpi_uuid_gen(bool reset, int wid, uint64_t PC) {
+  std::lock_guard<std::mutex> lock(g_uuid_mutex);
   if (reset) {
     g_uuid_gens.clear();
     return 0;
@@ -227,4 +259,79 @@ uint64_t dpi_uuid_gen(bool reset, int wid, uint64_t PC) {
   uint32_t instr_uuid = uuid_gen->get_uuid(PC);
   uint64_t uuid = (uint64_t(wid) << 32) | instr_uuid;
   return uuid;
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Core states reported by the schedulers of SIM_SKIP_IDLE builds. The harness
+// skips evaluation only while every core is stalled or done, and credits the
+// skipped cycles to the stalled cores, which add them to their cycle counters.
+
+enum {
+  IDLE_STATE_ACTIVE  = 0,
+  IDLE_STATE_STALLED = 1,
+  IDLE_STATE_DONE    = 2
+};
+
+struct idle_core_t {
+  int      state;
+  uint64_t skipped;
+};
+
+std::unordered_map<int, idle_core_t> g_idle_cores;
+uint32_t g_idle_quiet_cores = 0;
+int32_t g_idle_busy_units = 0;
+std::mutex g_idle_mutex;
+
+void dpi_idle_report(int core_id, int state) {
+  std::lock_guard<std::mutex> lock(g_idle_mutex);
+  auto& core = g_idle_cores[core_id];
+  g_idle_quiet_cores -= (core.state != IDLE_STATE_ACTIVE);
+  g_idle_quiet_cores += (state != IDLE_STATE_ACTIVE);
+  core.state = state;
+  if (state != IDLE_STATE_STALLED) {
+    core.skipped = 0;
+  }
+}
+
+uint64_t dpi_idle_skipped(int core_id) {
+  std::lock_guard<std::mutex> lock(g_idle_mutex);
+  auto it = g_idle_cores.find(core_id);
+  if (it == g_idle_cores.end())
+    return 0;
+  auto skipped = it->second.skipped;
+  it->second.skipped = 0;
+  return skipped;
+}
+
+// Units that may still change state without a core handshake (execute units,
+// LSU, caches) report when they turn busy or idle; the skip also waits on them.
+void dpi_idle_busy(bool busy) {
+  std::lock_guard<std::mutex> lock(g_idle_mutex);
+  g_idle_busy_units += busy ? 1 : -1;
+}
+
+uint32_t sim_idle_quiet_cores() {
+  std::lock_guard<std::mutex> lock(g_idle_mutex);
+  return g_idle_quiet_cores;
+}
+
+uint32_t sim_idle_busy_units() {
+  std::lock_guard<std::mutex> lock(g_idle_mutex);
+  return g_idle_busy_units;
+}
+
+// the units clear their busy state silently while in reset
+void sim_idle_reset() {
+  std::lock_guard<std::mutex> lock(g_idle_mutex);
+  g_idle_busy_units = 0;
+}
+
+void sim_idle_skip(uint64_t cycles) {
+  std::lock_guard<std::mutex> lock(g_idle_mutex);
+  for (auto& it : g_idle_cores) {
+    if (it.second.state == IDLE_STATE_STALLED) {
+      it.second.skipped += cycles;
+    }
+  }
+}
@@ -31,7 +31,12 @@ import "DPI-C" function void dpi_assert(int inst, input logic cond, input int de
 import "DPI-C" function void dpi_trace(input int level, input string format /*verilator sformat*/);
 import "DPI-C" function void dpi_trace_start();
 import "DPI-C" function void dpi_trace_stop();
+import "DPI-C" function void dpi_trace_pc(input longint PC);
 
 import "DPI-C" function longint dpi_uuid_gen(input logic reset, input int wid, input longint PC);
 
+import "DPI-C" function void dpi_idle_report(input int core_id, input int state);
+import "DPI-C" function longint dpi_idle_skipped(input int core_id);
+import "DPI-C" function void dpi_idle_busy(input logic busy);
+
 `endif
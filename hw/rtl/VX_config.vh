@@ -183,8 +183,39 @@
 `endif
 `define IO_COUT_SIZE `MEM_BLOCK_SIZE
 
+// the print port stays at a fixed address, independent of the device shape
+`ifndef IO_PRINT_ADDR
+`define IO_PRINT_ADDR (`IO_COUT_ADDR + `IO_COUT_SIZE)
+`endif
+`define IO_PRINT_SIZE `MEM_BLOCK_SIZE
+`define IO_PRINT_MAGIC 32'h42505856
+
+// per-thread print buffer, reserved at the top of each stack
+`ifndef PRINT_BUF_SIZE
+`define PRINT_BUF_SIZE 256
+`endif
+
+// per-warp profiling regions (see vx_prof.h)
+`ifndef PROF_MAX_REGIONS
+`define PROF_MAX_REGIONS 16
+`endif
+`ifndef PROF_RING_SIZE
+`define PROF_RING_SIZE 64
+`endif
+// device-wide, warps beyond it are not profiled
+`ifndef PROF_MAX_WARPS
+`define PROF_MAX_WARPS 256
+`endif
+`define PROF_WARP_SIZE (16 + 8 * `PROF_MAX_REGIONS + 16 * `PROF_RING_SIZE)
+
+// sized from PROF_MAX_WARPS, so the region does not move with the device shape
+`ifndef IO_PROF_ADDR
+`define IO_PROF_ADDR (`IO_PRINT_ADDR + `IO_PRINT_SIZE)
+`endif
+`define IO_PROF_SIZE (`PROF_WARP_SIZE * `PROF_MAX_WARPS)
+
 `ifndef IO_MPM_ADDR
-`define IO_MPM_ADDR (`IO_COUT_ADDR + `IO_COUT_SIZE)
+`define IO_MPM_ADDR (`IO_PROF_ADDR + `IO_PROF_SIZE)
 `endif
 `define IO_CSR_SIZE (4 * 64 * `NUM_CORES * `NUM_CLUSTERS)
 
@@ -441,4 +441,25 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// report a unit's activity to the simulation harness on every change, the
+// harness only skips idle cycles while no unit is busy (see sim/rtlsim)
+`ifdef SIM_SKIP_IDLE
+`define SIM_IDLE_BUSY(busy) \
+    if (1) begin \
+        reg __busy_r; \
+        always @(posedge clk) begin \
+            if (reset) begin \
+                __busy_r <= 0; \
+            end else if (__busy_r != (busy)) begin \
+                dpi_idle_busy(busy); \
+                __busy_r <= (busy); \
+            end \
+        end \
+    end
+`else
+`define SIM_IDLE_BUSY(busy)
+`endif
+
+///////////////////////////////////////////////////////////////////////////////
+
 `endif // VX_DEFINE_VH
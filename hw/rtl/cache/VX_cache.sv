@@ -593,4 +593,16 @@ module VX_cache import VX_gpu_pkg::*; #(
     assign cache_perf.crsp_stalls  = perf_crsp_stalls;
 `endif
 
+`ifdef SIM_SKIP_IDLE
+    wire [NUM_REQS-1:0] sim_core_fire;
+    for (genvar i = 0; i < NUM_REQS; ++i) begin
+        assign sim_core_fire[i] = (core_bus_if[i].req_valid && core_bus_if[i].req_ready)
+                               || (core_bus_if[i].rsp_valid && core_bus_if[i].rsp_ready);
+    end
+
+    `SIM_IDLE_BUSY ((| sim_core_fire)
+                 || (mem_bus_if.req_valid && mem_bus_if.req_ready)
+                 || (mem_bus_if.rsp_valid && mem_bus_if.rsp_ready))
+`endif
+
 endmodule
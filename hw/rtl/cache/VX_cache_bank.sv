@@ -546,4 +546,12 @@ module VX_cache_bank #(
     end
 `endif
 
+    `SIM_IDLE_BUSY (init_enable
+                 || ((valid_st0 || valid_st1) && ~crsq_stall)
+                 || core_req_fire
+                 || replay_fire
+                 || mem_rsp_fire
+                 || (core_rsp_valid && core_rsp_ready)
+                 || mreq_pop)
+
 endmodule
@@ -337,6 +337,76 @@ module VX_core import VX_gpu_pkg::*; #(
         end
     end
 
+`ifdef SIM_SKIP_IDLE
+
+    // report the core activity to the simulation harness for idle-cycle skipping:
+    // instructions in flight in the ALU, FPU and SFU, or any pipeline handshake
+
+    localparam SIM_EX_PORTS = `NUM_EX_UNITS * `ISSUE_WIDTH;
+
+    wire [SIM_EX_PORTS-1:0] sim_dispatch_fire;
+    wire [SIM_EX_PORTS-1:0] sim_commit_fire;
+    wire [`CLOG2(SIM_EX_PORTS+1)-1:0] sim_dispatch_cnt;
+    wire [`CLOG2(SIM_EX_PORTS+1)-1:0] sim_commit_cnt;
+    reg [15:0] sim_ex_pending;
+
+    for (genvar i = 0; i < SIM_EX_PORTS; ++i) begin
+        if ((i / `ISSUE_WIDTH) != `EX_LSU) begin
+            assign sim_dispatch_fire[i] = dispatch_if[i].valid && dispatch_if[i].ready;
+            assign sim_commit_fire[i] = commit_if[i].valid && commit_if[i].ready && commit_if[i].data.eop;
+        end else begin
+            assign sim_dispatch_fire[i] = 0;
+            assign sim_commit_fire[i] = 0;
+        end
+    end
+
+    `POP_COUNT(sim_dispatch_cnt, sim_dispatch_fire);
+    `POP_COUNT(sim_commit_cnt, sim_commit_fire);
+
+    always @(posedge clk) begin
+        if (reset) begin
+            sim_ex_pending <= '0;
+        end else begin
+            sim_ex_pending <= sim_ex_pending + 16'(sim_dispatch_cnt) - 16'(sim_commit_cnt);
+        end
+    end
+
+    wire [SIM_EX_PORTS-1:0] sim_ex_fire;
+    wire [`ISSUE_WIDTH-1:0] sim_wb_valid;
+    wire [`NUM_LSU_BLOCKS-1:0] sim_lsu_fire;
+    wire [DCACHE_NUM_REQS-1:0] sim_dcache_fire;
+
+    for (genvar i = 0; i < SIM_EX_PORTS; ++i) begin
+        assign sim_ex_fire[i] = (dispatch_if[i].valid && dispatch_if[i].ready)
+                             || (commit_if[i].valid && commit_if[i].ready);
+    end
+    for (genvar i = 0; i < `ISSUE_WIDTH; ++i) begin
+        assign sim_wb_valid[i] = writeback_if[i].valid;
+    end
+    for (genvar i = 0; i < `NUM_LSU_BLOCKS; ++i) begin
+        assign sim_lsu_fire[i] = (lsu_mem_if[i].req_valid && lsu_mem_if[i].req_ready)
+                              || (lsu_mem_if[i].rsp_valid && lsu_mem_if[i].rsp_ready);
+    end
+    for (genvar i = 0; i < DCACHE_NUM_REQS; ++i) begin
+        assign sim_dcache_fire[i] = (dcache_bus_if[i].req_valid && dcache_bus_if[i].req_ready)
+                                 || (dcache_bus_if[i].rsp_valid && dcache_bus_if[i].rsp_ready);
+    end
+
+    wire sim_busy = (sim_ex_pending != 0)
+                 || (schedule_if.valid && schedule_if.ready)
+                 || (fetch_if.valid && fetch_if.ready)
+                 || (decode_if.valid && decode_if.ready)
+                 || (icache_bus_if.req_valid && icache_bus_if.req_ready)
+                 || (icache_bus_if.rsp_valid && icache_bus_if.rsp_ready)
+                 || (| sim_ex_fire)
+                 || (| sim_wb_valid)
+                 || (| sim_lsu_fire)
+                 || (| sim_dcache_fire);
+
+    `SIM_IDLE_BUSY (sim_busy)
+
+`endif
+
 `ifdef PERF_ENABLE
 
     wire [`CLOG2(LSU_NUM_REQS+1)-1:0] perf_dcache_rd_req_per_cycle;
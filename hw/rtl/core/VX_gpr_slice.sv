@@ -283,4 +283,9 @@ module VX_gpr_slice import VX_gpu_pkg::*; #(
         );
     end
 
+    `SIM_IDLE_BUSY ((state != STATE_IDLE)
+                 || (scoreboard_if.valid && ~data_ready)
+                 || (scoreboard_if.valid && scoreboard_if.ready)
+                 || (operands_if.valid && operands_if.ready))
+
 endmodule
@@ -540,4 +540,9 @@ module VX_lsu_slice import VX_gpu_pkg::*; #(
     `SCOPE_IO_UNUSED()
 `endif
 
+    `SIM_IDLE_BUSY ((execute_if.valid && execute_if.ready)
+                 || mem_req_fire
+                 || mem_rsp_fire
+                 || commit_if.valid)
+
 endmodule
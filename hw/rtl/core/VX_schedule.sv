@@ -66,6 +66,10 @@ module VX_schedule import VX_gpu_pkg::*; #(
 
     reg [`PERF_CTR_BITS-1:0] cycles;
 
+`ifdef SIM_SKIP_IDLE
+    reg [1:0] sim_idle_state;
+`endif
+
     reg [`NUM_WARPS-1:0][`UUID_WIDTH-1:0] issued_instrs;
 
     wire schedule_fire = schedule_valid && schedule_ready;
@@ -271,7 +275,12 @@ module VX_schedule import VX_gpu_pkg::*; #(
             end
 
             if (busy) begin
+            `ifdef SIM_SKIP_IDLE
+                // include the cycles the simulation harness skipped while this core was stalled
+                cycles <= cycles + 1 + ((sim_idle_state == 1) ? `PERF_CTR_BITS'(dpi_idle_skipped(CORE_ID)) : '0);
+            `else
                 cycles <= cycles + 1;
+            `endif
             end
         end
     end
@@ -343,6 +352,14 @@ module VX_schedule import VX_gpu_pkg::*; #(
             instr_uuid <= `UUID_WIDTH'(dpi_uuid_gen(0, 32'(g_wid), 64'(schedule_pc)));
         end
     end
+`ifdef VCD_OUTPUT
+    // waveform trace triggers on scheduled PCs
+    always @(posedge clk) begin
+        if (~reset && schedule_fire) begin
+            dpi_trace_pc(64'({schedule_pc, 1'b0}));
+        end
+    end
+`endif
 `else
     wire [GNW_WIDTH+16-1:0] w_uuid = {g_wid, 16'(schedule_pc)};
     always @(*) begin
@@ -389,6 +406,24 @@ module VX_schedule import VX_gpu_pkg::*; #(
 
     `BUFFER_EX(busy, (active_warps != 0 || ~no_pending_instr), 1'b1, 1);
 
+`ifdef SIM_SKIP_IDLE
+    // report the core state to the simulation harness for idle-cycle skipping:
+    // 0 = active, 1 = every active warp stalled, 2 = done
+    wire [1:0] sim_idle_state_n = (active_warps == 0 && no_pending_instr) ? 2'd2 :
+                                  ((ready_warps == 0 && ~schedule_if.valid && ~wspawn.valid) ? 2'd1 : 2'd0);
+    always @(posedge clk) begin
+        if (reset) begin
+            if (sim_idle_state != 0) begin
+                dpi_idle_report(CORE_ID, 0);
+            end
+            sim_idle_state <= 0;
+        end else if (sim_idle_state_n != sim_idle_state) begin
+            dpi_idle_report(CORE_ID, 32'(sim_idle_state_n));
+            sim_idle_state <= sim_idle_state_n;
+        end
+    end
+`endif
+
     // export CSRs
     assign sched_csr_if.cycles = cycles;
     assign sched_csr_if.active_warps = active_warps;
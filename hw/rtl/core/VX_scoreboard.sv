@@ -330,6 +330,8 @@ module VX_scoreboard import VX_gpu_pkg::*; #(
             .ready_out (scoreboard_if[i].ready),
             .sel_out   (scoreboard_if[i].data.wis)
         );
+
+        `SIM_IDLE_BUSY (| (valid_in & ready_in))
     end
 
 endmodule
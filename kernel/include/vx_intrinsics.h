@@ -229,10 +229,168 @@ inline int vx_hart_id() {
     return ret;
 }
 
+// Warp vote: all active threads have a non-zero predicate
+inline int vx_vote_all(int predicate) {
+    int ret;
+    asm volatile (".insn r %1, 0, 1, %0, %2, x0" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(predicate));
+    return ret;
+}
+
+// Warp vote: any active thread has a non-zero predicate
+inline int vx_vote_any(int predicate) {
+    int ret;
+    asm volatile (".insn r %1, 1, 1, %0, %2, x0" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(predicate));
+    return ret;
+}
+
+// Warp vote: all active threads hold the same value
+inline int vx_vote_uni(int value) {
+    int ret;
+    asm volatile (".insn r %1, 2, 1, %0, %2, x0" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(value));
+    return ret;
+}
+
+// Warp vote: mask of the active threads with a non-zero predicate
+inline int vx_vote_ballot(int predicate) {
+    int ret;
+    asm volatile (".insn r %1, 3, 1, %0, %2, x0" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(predicate));
+    return ret;
+}
+
+// Warp shuffles: read value from another thread of the warp,
+// a thread keeps its own value when the source is out of range or inactive
+
+// from thread 'lane'
+inline int vx_shfl_idx(int value, int lane) {
+    int ret;
+    asm volatile (".insn r %1, 0, 2, %0, %2, %3" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(value), "r"(lane));
+    return ret;
+}
+
+// from thread 'tid - delta'
+inline int vx_shfl_up(int value, int delta) {
+    int ret;
+    asm volatile (".insn r %1, 1, 2, %0, %2, %3" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(value), "r"(delta));
+    return ret;
+}
+
+// from thread 'tid + delta'
+inline int vx_shfl_down(int value, int delta) {
+    int ret;
+    asm volatile (".insn r %1, 2, 2, %0, %2, %3" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(value), "r"(delta));
+    return ret;
+}
+
+// from thread 'tid ^ mask'
+inline int vx_shfl_xor(int value, int mask) {
+    int ret;
+    asm volatile (".insn r %1, 3, 2, %0, %2, %3" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(value), "r"(mask));
+    return ret;
+}
+
+// Warp reductions: every active thread receives the result over all active threads
+#define __VX_WARP_COLLECTIVE(name, func3, func7)                  \
+inline int name(int value) {                                      \
+    int ret;                                                      \
+    asm volatile (".insn r %1, " #func3 ", " #func7 ", %0, %2, x0" \
+        : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(value));            \
+    return ret;                                                   \
+}
+
+__VX_WARP_COLLECTIVE(vx_reduce_add, 0, 3)
+__VX_WARP_COLLECTIVE(vx_reduce_min, 1, 3)
+__VX_WARP_COLLECTIVE(vx_reduce_max, 2, 3)
+__VX_WARP_COLLECTIVE(vx_reduce_and, 3, 3)
+__VX_WARP_COLLECTIVE(vx_reduce_or,  4, 3)
+__VX_WARP_COLLECTIVE(vx_reduce_xor, 5, 3)
+
+// Warp inclusive scans, in thread order over the active threads
+__VX_WARP_COLLECTIVE(vx_scan_add, 0, 4)
+__VX_WARP_COLLECTIVE(vx_scan_min, 1, 4)
+__VX_WARP_COLLECTIVE(vx_scan_max, 2, 4)
+__VX_WARP_COLLECTIVE(vx_scan_and, 3, 4)
+__VX_WARP_COLLECTIVE(vx_scan_or,  4, 4)
+__VX_WARP_COLLECTIVE(vx_scan_xor, 5, 4)
+
+#undef __VX_WARP_COLLECTIVE
+
+// Cache control, addr may point anywhere inside the target cache line
+
+// Prefetch the line into the L1, L2 or L3 cache (and the levels below it)
+// without waiting for it; a level that is not present passes it down
+inline void vx_prefetch_l1(const void* addr) {
+    asm volatile (".insn r %0, 0, 5, x0, %1, x0" :: "i"(RISCV_CUSTOM0), "r"(addr));
+}
+
+inline void vx_prefetch_l2(const void* addr) {
+    asm volatile (".insn r %0, 1, 5, x0, %1, x0" :: "i"(RISCV_CUSTOM0), "r"(addr));
+}
+
+inline void vx_prefetch_l3(const void* addr) {
+    asm volatile (".insn r %0, 2, 5, x0, %1, x0" :: "i"(RISCV_CUSTOM0), "r"(addr));
+}
+
+// Streaming 32-bit load: a miss does not allocate a line in any cache level,
+// so data read once does not evict the working set
+inline int vx_load_na(const void* addr) {
+    int ret;
+    asm volatile (".insn r %1, 3, 5, %0, %2, x0" : "=r"(ret) : "i"(RISCV_CUSTOM0), "r"(addr) : "memory");
+    return ret;
+}
+
+// Write back and invalidate the line in every cache level
+inline void vx_flush_line(const void* addr) {
+    asm volatile (".insn r %0, 4, 5, x0, %1, x0" :: "i"(RISCV_CUSTOM0), "r"(addr) : "memory");
+}
+
+// Return the argument block of the current launch (see vx_arg_ring_start)
+// remains valid after vx_spawn_tasks() has reused mscratch
+extern void* __vx_kernel_args;
+inline void* vx_kernel_args() {
+    return __vx_kernel_args;
+}
+
 inline void vx_fence() {
     asm volatile ("fence iorw, iorw");
 }
 
+// Park the warp until the word at addr no longer holds value
+// encoded as a "sltu x0" custom hint, which executes as a nop on hardware without support
+inline void vx_wait_change(const volatile void* addr, size_t value) {
+    asm volatile (".insn r 0x33, 3, 0, x0, %0, %1" :: "r"(addr), "r"(value) : "memory");
+}
+
+// Deschedule the warp for at least 'cycles' cycles
+// encoded as a "slt x0" custom hint, which executes as a nop on hardware without support
+inline void vx_sleep(size_t cycles) {
+    asm volatile (".insn r 0x33, 2, 0, x0, %0, x0" :: "r"(cycles) : "memory");
+}
+
+// Give the issue slot to the other warps of the core
+inline void vx_yield() {
+    vx_sleep(0);
+}
+
+// Spin lock on a word of device memory, 0 when free (requires the A extension).
+// The threads of a warp only reconverge once all of them leave a loop, so the
+// critical section runs inside the retry loop rather than after it:
+//   for (int done = 0; !done;) {
+//     if (vx_lock_try(&lock)) { ...; vx_lock_release(&lock); done = 1; }
+//     else vx_lock_wait(&lock);
+//   }
+inline int vx_lock_try(volatile int* lock) {
+    return 0 == __atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE);
+}
+
+inline void vx_lock_release(volatile int* lock) {
+    __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+}
+
+// Park the warp while the lock is held instead of polling it
+inline void vx_lock_wait(volatile int* lock) {
+    vx_wait_change(lock, 1);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,44 @@
+// Copyright © 2019-2023
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __VX_MAILBOX_H__
+#define __VX_MAILBOX_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// mailbox layout, must match the host runtime (see vx_mailbox_create)
+typedef struct {
+  uint32_t head;        // number of submitted descriptors
+  uint32_t stop;        // set by the host to terminate the kernel
+  uint32_t doorbell;    // incremented by the host on every update
+  uint32_t capacity;    // number of ring entries
+  uint32_t desc_stride; // size of a ring entry in bytes
+  uint32_t desc_offset; // offset of the first ring entry
+  uint32_t done_offset; // offset of the per-core completion counters
+} vx_mailbox_t;
+
+typedef void (*vx_mailbox_cb)(const void* desc, void* arg);
+
+// Process the work descriptors submitted to the mailbox until the host stops it.
+// The callback is invoked on every core, in submission order.
+void vx_mailbox_serve(const void* mailbox, vx_mailbox_cb callback, void* arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __VX_MAILBOX_H__
@@ -0,0 +1,45 @@
+// Copyright © 2019-2023
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef __VX_MEMORY_H__
+#define __VX_MEMORY_H__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Word-wide copy and fill for a single thread.
+void vx_memcpy(void* dst, const void* src, size_t size);
+void vx_memset(void* dst, int value, size_t size);
+
+// Warp-cooperative copy and fill: every thread of the warp must call them
+// with the full thread mask and the same arguments. Consecutive threads move
+// consecutive words so that each warp access coalesces into cache lines.
+void vx_memcpy_warp(void* dst, const void* src, size_t size);
+void vx_memset_warp(void* dst, int value, size_t size);
+
+// Device heap, assigned by the host with vx_kernel_heap. Any thread may
+// allocate or free; a freed block is recycled by the thread that frees it.
+// Returns NULL when no heap is assigned or it is exhausted. Blocks are only
+// returned to the heap by the next cold launch. Requires the A extension.
+void* vx_malloc(size_t size);
+void vx_free(void* ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __VX_MEMORY_H__
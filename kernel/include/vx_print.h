@@ -27,6 +27,11 @@ void vx_putchar(int c);
 void vx_putint(int value, int base);
 void vx_putfloat(float value, int precision);
 
+// vx_printf, vx_putint and vx_putfloat write to a per-thread buffer that is
+// flushed when full, at kernel exit, or explicitly with vx_print_flush().
+// vx_putchar is unbuffered.
+void vx_print_flush();
+
 #ifdef __cplusplus
 }
 #endif
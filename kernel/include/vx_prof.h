@@ -0,0 +1,51 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __VX_PROF_H__
+#define __VX_PROF_H__
+
+#include <stdint.h>
+#include <VX_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// profiling layout at IO_PROF_ADDR, must match the host runtime (see vx_dump_prof)
+typedef struct {
+  uint32_t id;
+  uint32_t reserved;
+  uint32_t cycles;  // core cycles spent in the region
+  uint32_t instrs;  // instructions retired by the core during the region
+} vx_prof_record_t;
+
+typedef struct {
+  uint32_t count;   // records written since launch, the ring keeps the last PROF_RING_SIZE
+  uint32_t reserved[3];
+  uint32_t start_cycles[PROF_MAX_REGIONS];
+  uint32_t start_instrs[PROF_MAX_REGIONS];
+  vx_prof_record_t ring[PROF_RING_SIZE];
+} vx_prof_warp_t;
+
+// Mark a profiling region of the calling warp, id is in [0, PROF_MAX_REGIONS).
+// Only the first PROF_MAX_WARPS warps of the device are profiled.
+// Regions with different ids may nest. Every vx_prof_end appends a record to
+// the warp's ring; the host aggregates them with vx_dump_prof.
+void vx_prof_begin(uint32_t id);
+void vx_prof_end(uint32_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __VX_PROF_H__
@@ -27,12 +27,57 @@ typedef void (*vx_spawn_task_groups_cb)(int local_task_id, int group_id, int loc
 
 typedef void (*vx_serial_cb)(void *arg);
 
+typedef void (*vx_spawn_threads_cb)(void *arg);
+
+typedef struct {
+  uint32_t x;
+  uint32_t y;
+  uint32_t z;
+} dim3_t;
+
+// grid launch indices, valid inside a vx_spawn_threads() callback
+extern __thread dim3_t blockIdx;
+extern __thread dim3_t threadIdx;
+extern __thread dim3_t globalIdx;
+extern dim3_t gridDim;
+extern dim3_t blockDim;
+
+// group slot of the calling thread within its core
+extern __thread uint32_t __local_group_id;
+extern __thread void* __local_group_mem;
+extern uint32_t __warps_per_group;
+
 void vx_spawn_tasks(int num_tasks, vx_spawn_tasks_cb callback, void * arg);
 
+// Dynamic variant of vx_spawn_tasks: warps pull chunk_size tasks at a time
+// from an atomic counter in device memory, so slow tasks don't hold back a
+// statically assigned core. counter must be zero at the call and is consumed
+// by it. Requires the A extension.
+void vx_spawn_tasks_dyn(int num_tasks, int chunk_size, int* counter, vx_spawn_tasks_cb callback, void * arg);
+
+// Same as vx_spawn_tasks_dyn with one queue per core: warps drain their own
+// core's share of the range first, then steal chunks from the other cores.
+// counters holds vx_num_cores() zeroed entries.
+void vx_spawn_tasks_steal(int num_tasks, int chunk_size, int* counters, vx_spawn_tasks_cb callback, void * arg);
+
 void vx_spawn_task_groups(int num_groups, int group_size, vx_spawn_task_groups_cb callback, void * arg);
 
 void vx_serial(vx_serial_cb callback, void * arg);
 
+// Launch a 1-D to 3-D grid of blocks (grid_dim counts blocks, block_dim
+// counts threads per block). Each block receives local_mem_size bytes of
+// local memory, and the number of blocks resident on a core is capped so
+// that their local memory and barriers fit.
+void vx_spawn_threads(uint32_t dimension, const uint32_t* grid_dim, const uint32_t* block_dim, uint32_t local_mem_size, vx_spawn_threads_cb callback, void * arg);
+
+// local memory of the calling thread's block
+inline void* vx_local_mem() {
+  return __local_group_mem;
+}
+
+// synchronize the warps of the calling thread's block
+#define __syncthreads() vx_barrier(__local_group_id, __warps_per_group)
+
 #ifdef __cplusplus
 }
 #endif
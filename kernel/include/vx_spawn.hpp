@@ -0,0 +1,163 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __VX_SPAWN_HPP__
+#define __VX_SPAWN_HPP__
+
+#include <vx_spawn.h>
+#include <vx_intrinsics.h>
+
+// C++ variant of vx_spawn_tasks taking the kernel body as a functor or lambda
+// called with the task id. The per-warp task loop is instantiated for each
+// body, so the body is inlined into it instead of being called through a
+// function pointer for every task. Tasks are distributed as in vx_spawn_tasks.
+//
+//   vx_spawn_tasks(arg->num_points, [=](int task_id) {
+//     dst[task_id] = src0[task_id] + src1[task_id];
+//   });
+
+namespace vortex {
+namespace detail {
+
+template <typename F>
+struct spawn_tasks_args_t {
+  const F* body;
+  int all_tasks_offset;
+  int remain_tasks_offset;
+  int warp_batches;
+  int remaining_warps;
+};
+
+// The task loops run after a thread mask change, so they are kept out of line
+// and reload their state from MSCRATCH: registers computed by thread0 before
+// the change are not valid in the other threads.
+template <typename F>
+__attribute__((noinline)) void process_all_tasks() {
+  auto targs = (const spawn_tasks_args_t<F>*)csr_read(VX_CSR_MSCRATCH);
+
+  int threads_per_warp = vx_num_threads();
+  int warp_id = vx_warp_id();
+  int thread_id = vx_thread_id();
+
+  int remaining_warps = targs->remaining_warps;
+  int start_warp = (warp_id * targs->warp_batches) + ((warp_id < remaining_warps) ? warp_id : remaining_warps);
+  int iterations = targs->warp_batches + (warp_id < remaining_warps);
+
+  int start_task_id = targs->all_tasks_offset + (start_warp * threads_per_warp) + thread_id;
+  int end_task_id = start_task_id + iterations * threads_per_warp;
+
+  const F& body = *targs->body;
+  for (int task_id = start_task_id; task_id < end_task_id; task_id += threads_per_warp) {
+    body(task_id);
+  }
+}
+
+template <typename F>
+__attribute__((noinline)) void process_remaining_tasks() {
+  auto targs = (const spawn_tasks_args_t<F>*)csr_read(VX_CSR_MSCRATCH);
+  (*targs->body)(targs->remain_tasks_offset + vx_thread_id());
+}
+
+template <typename F>
+__attribute__((noinline)) void process_all_tasks_stub() {
+  // activate all threads
+  vx_tmc(-1);
+
+  // process all tasks
+  process_all_tasks<F>();
+
+  // disable warp
+  vx_tmc_zero();
+}
+
+} // namespace detail
+} // namespace vortex
+
+template <typename F>
+void vx_spawn_tasks(int num_tasks, const F& body) {
+  // device specifications
+  int num_cores = vx_num_cores();
+  int warps_per_core = vx_num_warps();
+  int threads_per_warp = vx_num_threads();
+  int core_id = vx_core_id();
+
+  // calculate necessary active cores
+  int threads_per_core = warps_per_core * threads_per_warp;
+  int needed_cores = (num_tasks + threads_per_core - 1) / threads_per_core;
+  int active_cores = (needed_cores < num_cores) ? needed_cores : num_cores;
+
+  // only active cores participate
+  if (core_id >= active_cores)
+    return;
+
+  // number of tasks per core
+  int base_tasks_per_core = num_tasks / active_cores;
+  int remaining_tasks_per_core = num_tasks - base_tasks_per_core * active_cores;
+  int tasks_per_core = base_tasks_per_core + (core_id < remaining_tasks_per_core);
+
+  // calculate number of warps to activate
+  int total_warps_per_core = tasks_per_core / threads_per_warp;
+  int remaining_tasks = tasks_per_core - total_warps_per_core * threads_per_warp;
+  int active_warps = total_warps_per_core;
+  int warp_batches = 1, remaining_warps = 0;
+  if (active_warps > warps_per_core) {
+    active_warps = warps_per_core;
+    warp_batches = total_warps_per_core / active_warps;
+    remaining_warps = total_warps_per_core - warp_batches * active_warps;
+  }
+
+  // calculate offsets for task distribution
+  int all_tasks_offset = core_id * base_tasks_per_core + ((core_id < remaining_tasks_per_core) ? core_id : remaining_tasks_per_core);
+  int remain_tasks_offset = all_tasks_offset + (tasks_per_core - remaining_tasks);
+
+  // prepare scheduler arguments
+  vortex::detail::spawn_tasks_args_t<F> wspawn_args = {
+    &body,
+    all_tasks_offset,
+    remain_tasks_offset,
+    warp_batches,
+    remaining_warps
+  };
+  csr_write(VX_CSR_MSCRATCH, &wspawn_args);
+
+  if (active_warps >= 1) {
+    // execute the body on other warps
+    vx_wspawn(active_warps, vortex::detail::process_all_tasks_stub<F>);
+
+    // activate all threads
+    vx_tmc(-1);
+
+    // process all tasks
+    vortex::detail::process_all_tasks<F>();
+
+    // back to single-threaded
+    vx_tmc_one();
+  }
+
+  if (remaining_tasks != 0) {
+    // activate remaining threads
+    int tmask = (1 << remaining_tasks) - 1;
+    vx_tmc(tmask);
+
+    // process remaining tasks
+    vortex::detail::process_remaining_tasks<F>();
+
+    // back to single-threaded
+    vx_tmc_one();
+  }
+
+  // wait for spawned tasks to complete
+  vx_wspawn(1, 0);
+}
+
+#endif // __VX_SPAWN_HPP__
@@ -145,12 +145,15 @@ static inline void _out_null(char character, void* buffer, size_t idx, size_t ma
 }
 
 
+// buffered output, see vx_print.c
+extern void __vx_print_putc(int c);
+
 // internal _putchar wrapper
 static inline void _out_char(char character, void* buffer, size_t idx, size_t maxlen)
 {
   (void)buffer; (void)idx; (void)maxlen;
   if (character) {
-    vx_putchar(character);
+    __vx_print_putc(character);
   }
 }
 
@@ -0,0 +1,130 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vx_memory.h>
+#include <vx_spawn.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Device heap.
+// The host assigns the heap region with vx_kernel_heap, which patches the
+// startup header (see vx_start.S). Each thread owns an arena in its TLS:
+// small blocks are carved from chunks that the arena bumps off the shared
+// heap with a single atomic add, and freed blocks go to the arena's
+// power-of-two size-class lists. Only the refill touches shared state.
+
+#define HEAP_MIN_LOG2    4    // 16-byte smallest class
+#define HEAP_NUM_CLASSES 20   // 8 MB largest class
+#define HEAP_CHUNK_SIZE  1024 // arena refill size
+#define HEAP_HEADER_SIZE 8    // keeps the payload 8-byte aligned
+
+extern uint64_t __vx_heap_base;
+extern uint64_t __vx_heap_size;
+
+// bytes taken from the heap, cleared with the BSS at cold start
+static size_t __heap_used;
+
+typedef struct {
+  char* cur;
+  char* end;
+  void* free_lists[HEAP_NUM_CLASSES];
+} heap_arena_t;
+
+static __thread heap_arena_t __heap_arena;
+
+typedef struct {
+  size_t size;
+  void*  ptr;
+} heap_arg_t;
+
+void* __vx_heap_bump(size_t size) {
+  // only commit requests that fit, so a failed large one leaves room for smaller ones
+  size_t offset = __atomic_load_n(&__heap_used, __ATOMIC_RELAXED);
+  do {
+    if (size > (size_t)__vx_heap_size - offset)
+      return NULL;
+  } while (!__atomic_compare_exchange_n(&__heap_used, &offset, offset + size, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  return (void*)((size_t)__vx_heap_base + offset);
+}
+
+static void __malloc_cb(heap_arg_t* arg) {
+  heap_arena_t* arena = &__heap_arena;
+
+  uint32_t cls = 0;
+  while (((size_t)1 << (cls + HEAP_MIN_LOG2)) < (arg->size + HEAP_HEADER_SIZE)) {
+    ++cls;
+  }
+  if (cls >= HEAP_NUM_CLASSES) {
+    arg->ptr = NULL;
+    return;
+  }
+
+  size_t block_size = (size_t)1 << (cls + HEAP_MIN_LOG2);
+  char* block = (char*)arena->free_lists[cls];
+  if (block) {
+    // reuse a freed block, its payload holds the list link
+    arena->free_lists[cls] = *(void**)(block + HEAP_HEADER_SIZE);
+  } else if (block_size >= HEAP_CHUNK_SIZE) {
+    block = (char*)__vx_heap_bump(block_size);
+  } else {
+    if ((size_t)(arena->end - arena->cur) < block_size) {
+      char* chunk = (char*)__vx_heap_bump(HEAP_CHUNK_SIZE);
+      if (chunk) {
+        arena->cur = chunk;
+        arena->end = chunk + HEAP_CHUNK_SIZE;
+      }
+    }
+    if ((size_t)(arena->end - arena->cur) >= block_size) {
+      block = arena->cur;
+      arena->cur += block_size;
+    }
+  }
+
+  if (block == NULL) {
+    arg->ptr = NULL;
+    return;
+  }
+
+  *(uint32_t*)block = cls;
+  arg->ptr = block + HEAP_HEADER_SIZE;
+}
+
+static void __free_cb(heap_arg_t* arg) {
+  if (arg->ptr == NULL)
+    return;
+  heap_arena_t* arena = &__heap_arena;
+  char* block = (char*)arg->ptr - HEAP_HEADER_SIZE;
+  uint32_t cls = *(uint32_t*)block;
+  *(void**)arg->ptr = arena->free_lists[cls];
+  arena->free_lists[cls] = block;
+}
+
+void* vx_malloc(size_t size) {
+  heap_arg_t arg;
+  arg.size = size;
+  vx_serial((vx_serial_cb)__malloc_cb, &arg);
+  return arg.ptr;
+}
+
+void vx_free(void* ptr) {
+  heap_arg_t arg;
+  arg.ptr = ptr;
+  vx_serial((vx_serial_cb)__free_cb, &arg);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,52 @@
+// Copyright © 2019-2023
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vx_mailbox.h>
+#include <vx_intrinsics.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vx_mailbox_serve(const void* mailbox, vx_mailbox_cb callback, void* arg) {
+  volatile vx_mailbox_t* mbox = (volatile vx_mailbox_t*)mailbox;
+  volatile uint32_t* done = (volatile uint32_t*)((const uint8_t*)mailbox + mbox->done_offset) + vx_core_id();
+
+  const uint8_t* ring = (const uint8_t*)mailbox + mbox->desc_offset;
+  uint32_t capacity = mbox->capacity;
+  uint32_t desc_stride = mbox->desc_stride;
+
+  // resume after the last completed descriptor
+  uint32_t tail = *done;
+
+  for (;;) {
+    // sample the doorbell before checking for work to not miss an update
+    uint32_t doorbell = mbox->doorbell;
+    if (mbox->head != tail) {
+      const void* desc = ring + (tail % capacity) * desc_stride;
+      callback(desc, arg);
+      // publish completion after all results are written
+      vx_fence();
+      *done = ++tail;
+      continue;
+    }
+    if (mbox->stop)
+      break;
+    // park the warp until the host rings the doorbell
+    vx_wait_change(&mbox->doorbell, doorbell);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,245 @@
+// Copyright © 2019-2023
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <vx_memory.h>
+#include <vx_intrinsics.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// keep gcc from turning the loops below back into memcpy/memset calls
+#define NO_BUILTIN_LOOPS __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+// keep the compiler from moving memory accesses across thread mask changes
+#define MASK_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+
+#define WORD_UNROLL 4
+
+static inline uint32_t fill_word(int value) {
+  return (uint8_t)value * 0x01010101u;
+}
+
+void NO_BUILTIN_LOOPS vx_memcpy(void* dst, const void* src, size_t size) {
+  uint8_t* d = (uint8_t*)dst;
+  const uint8_t* s = (const uint8_t*)src;
+
+  if ((((size_t)d ^ (size_t)s) & 3) == 0) {
+    while (((size_t)d & 3) && size != 0) {
+      *d++ = *s++;
+      --size;
+    }
+    uint32_t* dw = (uint32_t*)d;
+    const uint32_t* sw = (const uint32_t*)s;
+    size_t num_words = size >> 2;
+    size_t i = 0;
+    for (; i + WORD_UNROLL <= num_words; i += WORD_UNROLL) {
+      uint32_t w0 = sw[i + 0];
+      uint32_t w1 = sw[i + 1];
+      uint32_t w2 = sw[i + 2];
+      uint32_t w3 = sw[i + 3];
+      dw[i + 0] = w0;
+      dw[i + 1] = w1;
+      dw[i + 2] = w2;
+      dw[i + 3] = w3;
+    }
+    for (; i < num_words; ++i) {
+      dw[i] = sw[i];
+    }
+    d = (uint8_t*)(dw + num_words);
+    s = (const uint8_t*)(sw + num_words);
+    size &= 3;
+  }
+
+  while (size != 0) {
+    *d++ = *s++;
+    --size;
+  }
+}
+
+void NO_BUILTIN_LOOPS vx_memset(void* dst, int value, size_t size) {
+  uint8_t* d = (uint8_t*)dst;
+
+  while (((size_t)d & 3) && size != 0) {
+    *d++ = (uint8_t)value;
+    --size;
+  }
+
+  uint32_t w = fill_word(value);
+  uint32_t* dw = (uint32_t*)d;
+  size_t num_words = size >> 2;
+  size_t i = 0;
+  for (; i + WORD_UNROLL <= num_words; i += WORD_UNROLL) {
+    dw[i + 0] = w;
+    dw[i + 1] = w;
+    dw[i + 2] = w;
+    dw[i + 3] = w;
+  }
+  for (; i < num_words; ++i) {
+    dw[i] = w;
+  }
+
+  d = (uint8_t*)(dw + num_words);
+  size &= 3;
+  while (size != 0) {
+    *d++ = (uint8_t)value;
+    --size;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The warp loops below only branch on values shared by all threads, since
+// the library is built without divergence support. The last partial row of
+// a transfer runs under a reduced thread mask.
+
+static void NO_BUILTIN_LOOPS copy_words_warp(uint32_t* d, const uint32_t* s, size_t count, int thread_id, int num_threads) {
+  size_t stride = num_threads * WORD_UNROLL;
+  size_t batches = count / stride;
+  d += thread_id;
+  s += thread_id;
+  for (size_t i = 0; i < batches; ++i) {
+    uint32_t w0 = s[0];
+    uint32_t w1 = s[num_threads];
+    uint32_t w2 = s[2 * num_threads];
+    uint32_t w3 = s[3 * num_threads];
+    d[0] = w0;
+    d[num_threads] = w1;
+    d[2 * num_threads] = w2;
+    d[3 * num_threads] = w3;
+    d += stride;
+    s += stride;
+  }
+  count -= batches * stride;
+  size_t rows = count / num_threads;
+  for (size_t i = 0; i < rows; ++i) {
+    d[0] = s[0];
+    d += num_threads;
+    s += num_threads;
+  }
+  size_t remaining = count - rows * num_threads;
+  if (remaining != 0) {
+    vx_tmc((1 << remaining) - 1);
+    MASK_BARRIER();
+    d[0] = s[0];
+    MASK_BARRIER();
+    vx_tmc(-1);
+  }
+}
+
+static void NO_BUILTIN_LOOPS fill_words_warp(uint32_t* d, uint32_t w, size_t count, int thread_id, int num_threads) {
+  size_t stride = num_threads * WORD_UNROLL;
+  size_t batches = count / stride;
+  d += thread_id;
+  for (size_t i = 0; i < batches; ++i) {
+    d[0] = w;
+    d[num_threads] = w;
+    d[2 * num_threads] = w;
+    d[3 * num_threads] = w;
+    d += stride;
+  }
+  count -= batches * stride;
+  size_t rows = count / num_threads;
+  for (size_t i = 0; i < rows; ++i) {
+    d[0] = w;
+    d += num_threads;
+  }
+  size_t remaining = count - rows * num_threads;
+  if (remaining != 0) {
+    vx_tmc((1 << remaining) - 1);
+    MASK_BARRIER();
+    d[0] = w;
+    MASK_BARRIER();
+    vx_tmc(-1);
+  }
+}
+
+static void NO_BUILTIN_LOOPS copy_bytes_warp(uint8_t* d, const uint8_t* s, size_t count, int thread_id, int num_threads) {
+  size_t rows = count / num_threads;
+  d += thread_id;
+  s += thread_id;
+  for (size_t i = 0; i < rows; ++i) {
+    d[0] = s[0];
+    d += num_threads;
+    s += num_threads;
+  }
+  size_t remaining = count - rows * num_threads;
+  if (remaining != 0) {
+    vx_tmc((1 << remaining) - 1);
+    MASK_BARRIER();
+    d[0] = s[0];
+    MASK_BARRIER();
+    vx_tmc(-1);
+  }
+}
+
+void vx_memcpy_warp(void* dst, const void* src, size_t size) {
+  int thread_id = vx_thread_id();
+  int num_threads = vx_num_threads();
+  uint8_t* d = (uint8_t*)dst;
+  const uint8_t* s = (const uint8_t*)src;
+
+  // no common word alignment, stay byte-wide
+  if (((size_t)d ^ (size_t)s) & 3) {
+    copy_bytes_warp(d, s, size, thread_id, num_threads);
+    return;
+  }
+
+  size_t head = (-(size_t)d) & 3;
+  if (head > size)
+    head = size;
+  size_t num_words = (size - head) >> 2;
+  size_t tail = size - head - (num_words << 2);
+
+  // unaligned edges on thread0
+  if ((head | tail) != 0) {
+    vx_tmc_one();
+    MASK_BARRIER();
+    vx_memcpy(d, s, head);
+    vx_memcpy(d + size - tail, s + size - tail, tail);
+    MASK_BARRIER();
+    vx_tmc(-1);
+  }
+
+  copy_words_warp((uint32_t*)(d + head), (const uint32_t*)(s + head), num_words, thread_id, num_threads);
+}
+
+void vx_memset_warp(void* dst, int value, size_t size) {
+  int thread_id = vx_thread_id();
+  int num_threads = vx_num_threads();
+  uint8_t* d = (uint8_t*)dst;
+
+  size_t head = (-(size_t)d) & 3;
+  if (head > size)
+    head = size;
+  size_t num_words = (size - head) >> 2;
+  size_t tail = size - head - (num_words << 2);
+
+  // unaligned edges on thread0
+  if ((head | tail) != 0) {
+    vx_tmc_one();
+    MASK_BARRIER();
+    vx_memset(d, value, head);
+    vx_memset(d + size - tail, value, tail);
+    MASK_BARRIER();
+    vx_tmc(-1);
+  }
+
+  fill_words_warp((uint32_t*)(d + head), fill_word(value), num_words, thread_id, num_threads);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,12 +19,20 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <VX_config.h>
 #include "tinyprintf.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// per-thread print buffer, reserved by the startup code at the top of each stack
+typedef struct {
+	uint32_t size;
+	uint32_t hart;
+	char     data[PRINT_BUF_SIZE - 2 * sizeof(uint32_t)];
+} print_buf_t;
+
 typedef struct {
 	const char* format;
 	va_list*    va;
@@ -41,6 +49,51 @@ typedef struct {
 	int precision;
 } putfloat_arg_t;
 
+static inline print_buf_t* __print_buf(uint32_t hart) {
+	size_t stack_top = (size_t)STACK_BASE_ADDR - ((size_t)hart << STACK_LOG2_SIZE);
+	return (print_buf_t*)(stack_top - PRINT_BUF_SIZE);
+}
+
+static void __print_flush(print_buf_t* buf) {
+	uint32_t size = buf->size;
+	if (size == 0)
+		return;
+	volatile size_t* print_port = (volatile size_t*)(size_t)IO_PRINT_ADDR;
+	if (*(volatile uint32_t*)print_port == IO_PRINT_MAGIC) {
+		// the platform drains the whole buffer in one request
+		vx_fence();
+		*print_port = (size_t)buf;
+	} else {
+		volatile char* cout = (volatile char*)((size_t)IO_COUT_ADDR + (buf->hart & (IO_COUT_SIZE-1)));
+		for (uint32_t i = 0; i < size; ++i) {
+			*cout = buf->data[i];
+		}
+	}
+	buf->size = 0;
+}
+
+void __vx_print_putc(int c) {
+	print_buf_t* buf = __print_buf(csr_read(VX_CSR_MHARTID));
+	buf->data[buf->size++] = c;
+	if (buf->size == sizeof(buf->data)) {
+		__print_flush(buf);
+	}
+}
+
+// called by _Exit on the main thread: drain every thread of the core
+void __vx_print_flush_all() {
+	uint32_t threads_per_core = vx_num_warps() * vx_num_threads();
+	uint32_t hart_base = vx_core_id() * threads_per_core;
+	for (uint32_t i = 0; i < threads_per_core; ++i) {
+		__print_flush(__print_buf(hart_base + i));
+	}
+}
+
+static void __print_flush_cb(void* arg) {
+	(void)arg;
+	__print_flush(__print_buf(csr_read(VX_CSR_MHARTID)));
+}
+
 static void __putint_cb(const putint_arg_t* arg) {	
 	char tmp[33];
 	float value = arg->value;
@@ -50,7 +103,7 @@ static void __putint_cb(const putint_arg_t* arg) {
 		int c = tmp[i];
 		if (!c) 
 			break;
-		vx_putchar(c);
+		__vx_print_putc(c);
 	}
 }
 
@@ -60,7 +113,7 @@ static void __putfloat_cb(const putfloat_arg_t* arg) {
 	int ipart = (int)value;
     vx_putint(ipart, 10);
     if (precision != 0) {
-        vx_putchar('.');
+        __vx_print_putc('.');
 		float frac = value - (float)ipart;
         float fscaled = frac * pow(10, precision);  
         vx_putint((int)fscaled, 10);
@@ -85,6 +138,10 @@ void vx_putfloat(float value, int precision) {
 	vx_serial((vx_serial_cb)__putfloat_cb, &arg);
 }
 
+void vx_print_flush() {
+	vx_serial(__print_flush_cb, NULL);
+}
+
 int vx_vprintf(const char* format, va_list va) {
 	printf_arg_t arg;
 	arg.format = format;
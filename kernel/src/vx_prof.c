@@ -0,0 +1,68 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vx_prof.h>
+#include <vx_intrinsics.h>
+#include <VX_types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+_Static_assert(sizeof(vx_prof_warp_t) == PROF_WARP_SIZE, "invalid profiling layout");
+
+// all active threads of the warp store the same values,
+// so the updates below need no thread selection
+static inline vx_prof_warp_t* __prof_warp() {
+	uint32_t warp_id = vx_core_id() * vx_num_warps() + vx_warp_id();
+	if (warp_id >= PROF_MAX_WARPS)
+		return NULL; // outside of the profiling region
+	return (vx_prof_warp_t*)((size_t)IO_PROF_ADDR + warp_id * sizeof(vx_prof_warp_t));
+}
+
+// called by the startup code on every warp
+void __vx_prof_reset() {
+	vx_prof_warp_t* warp = __prof_warp();
+	if (warp == NULL)
+		return;
+	warp->count = 0;
+}
+
+void vx_prof_begin(uint32_t id) {
+	volatile vx_prof_warp_t* warp = __prof_warp();
+	if (warp == NULL)
+		return;
+	uint32_t slot = id % PROF_MAX_REGIONS;
+	warp->start_instrs[slot] = csr_read(VX_CSR_MINSTRET);
+	warp->start_cycles[slot] = csr_read(VX_CSR_MCYCLE);
+}
+
+void vx_prof_end(uint32_t id) {
+	uint32_t cycles = csr_read(VX_CSR_MCYCLE);
+	uint32_t instrs = csr_read(VX_CSR_MINSTRET);
+	volatile vx_prof_warp_t* warp = __prof_warp();
+	if (warp == NULL)
+		return;
+	uint32_t slot = id % PROF_MAX_REGIONS;
+	uint32_t count = warp->count;
+	volatile vx_prof_record_t* record = &warp->ring[count % PROF_RING_SIZE];
+	record->id = id;
+	record->cycles = cycles - warp->start_cycles[slot];
+	record->instrs = instrs - warp->start_instrs[slot];
+	warp->count = count + 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -15,6 +15,7 @@
 #include <vx_intrinsics.h>
 #include <inttypes.h>
 #include <vx_print.h>
+#include <VX_config.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -90,10 +91,9 @@ void vx_spawn_tasks(int num_tasks, vx_spawn_tasks_cb callback , void * arg) {
     return;
 
   // number of tasks per core
-  int tasks_per_core = num_tasks / active_cores;
-  int remaining_tasks_per_core = num_tasks - tasks_per_core * active_cores;
-  if (core_id < remaining_tasks_per_core)
-    tasks_per_core++;
+  int base_tasks_per_core = num_tasks / active_cores;
+  int remaining_tasks_per_core = num_tasks - base_tasks_per_core * active_cores;
+  int tasks_per_core = base_tasks_per_core + (core_id < remaining_tasks_per_core);
 
   // calculate number of warps to activate
   int total_warps_per_core = tasks_per_core / threads_per_warp;
@@ -107,7 +107,7 @@ void vx_spawn_tasks(int num_tasks, vx_spawn_tasks_cb callback , void * arg) {
   }
 
   // calculate offsets for task distribution
-  int all_tasks_offset = core_id * tasks_per_core + MIN(core_id, remaining_tasks_per_core);
+  int all_tasks_offset = core_id * base_tasks_per_core + MIN(core_id, remaining_tasks_per_core);
   int remain_tasks_offset = all_tasks_offset + (tasks_per_core - remaining_tasks);
 
   // prepare scheduler arguments
@@ -153,6 +153,143 @@ void vx_spawn_tasks(int num_tasks, vx_spawn_tasks_cb callback , void * arg) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// keep the compiler from moving memory accesses across thread mask changes
+#define MASK_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+
+typedef struct {
+  vx_spawn_tasks_cb callback;
+  void* arg;
+  int* counters;
+  int num_queues;
+  int num_tasks;
+  int chunk_size;
+  volatile int* chunk_slots;
+} wspawn_dyn_tasks_args_t;
+
+static void __attribute__ ((noinline)) process_dyn_tasks() {
+  wspawn_dyn_tasks_args_t* targs = (wspawn_dyn_tasks_args_t*)csr_read(VX_CSR_MSCRATCH);
+
+  int threads_per_warp = vx_num_threads();
+  int thread_id = vx_thread_id();
+  volatile int* slot = targs->chunk_slots + vx_warp_id();
+
+  int num_queues = targs->num_queues;
+  int chunk_size = targs->chunk_size;
+  int tasks_per_queue = targs->num_tasks / num_queues;
+  int remaining_tasks = targs->num_tasks - tasks_per_queue * num_queues;
+
+  vx_spawn_tasks_cb callback = targs->callback;
+  void* arg = targs->arg;
+
+  // start with the local queue, then visit the other cores' queues in turn
+  int queue = (num_queues > 1) ? vx_core_id() : 0;
+  for (int i = 0; i < num_queues; ++i) {
+    int queue_offset = queue * tasks_per_queue + MIN(queue, remaining_tasks);
+    int queue_size = tasks_per_queue + (queue < remaining_tasks);
+    int* counter = targs->counters + queue;
+
+    for (;;) {
+      // grab the next chunk on thread0 and share it with the warp
+      vx_tmc_one();
+      MASK_BARRIER();
+      *slot = __atomic_fetch_add(counter, chunk_size, __ATOMIC_RELAXED);
+      MASK_BARRIER();
+      vx_tmc(-1);
+      int offset = *slot;
+      if (offset >= queue_size)
+        break;
+
+      int start_task_id = queue_offset + offset;
+      int chunk_tasks = MIN(chunk_size, queue_size - offset);
+      int iterations = chunk_tasks / threads_per_warp;
+      int remaining = chunk_tasks - iterations * threads_per_warp;
+
+      int task_id = start_task_id + thread_id;
+      for (int j = 0; j < iterations; ++j) {
+        callback(task_id, arg);
+        task_id += threads_per_warp;
+      }
+
+      if (remaining != 0) {
+        // only the last chunk of a queue can be partial
+        vx_tmc((1 << remaining) - 1);
+        callback(task_id, arg);
+        vx_tmc(-1);
+      }
+    }
+
+    if (++queue == num_queues)
+      queue = 0;
+  }
+}
+
+static void __attribute__ ((noinline)) process_dyn_tasks_stub() {
+  // activate all threads
+  vx_tmc(-1);
+
+  // process all tasks
+  process_dyn_tasks();
+
+  // disable warp
+  vx_tmc_zero();
+}
+
+static void spawn_dyn_tasks(int num_tasks, int chunk_size, int* counters, int num_queues, vx_spawn_tasks_cb callback, void * arg) {
+  int warps_per_core = vx_num_warps();
+  int threads_per_warp = vx_num_threads();
+
+  // chunks are processed a full warp at a time
+  if (chunk_size < threads_per_warp)
+    chunk_size = threads_per_warp;
+  chunk_size = ((chunk_size + threads_per_warp - 1) / threads_per_warp) * threads_per_warp;
+
+  // every core takes part since work is pulled, not assigned
+  int num_chunks = (num_tasks + chunk_size - 1) / chunk_size;
+  int active_warps = MIN(num_chunks, warps_per_core);
+  if (active_warps == 0)
+    return;
+
+  // per-warp mailbox used to broadcast the grabbed chunk
+  int chunk_slots[warps_per_core];
+
+  // prepare scheduler arguments
+  wspawn_dyn_tasks_args_t wspawn_args = {
+    callback,
+    arg,
+    counters,
+    num_queues,
+    num_tasks,
+    chunk_size,
+    chunk_slots
+  };
+  csr_write(VX_CSR_MSCRATCH, &wspawn_args);
+
+  // execute callback on other warps
+  vx_wspawn(active_warps, process_dyn_tasks_stub);
+
+  // activate all threads
+  vx_tmc(-1);
+
+  // process all tasks
+  process_dyn_tasks();
+
+  // back to single-threaded
+  vx_tmc_one();
+
+  // wait for spawned tasks to complete
+  vx_wspawn(1, 0);
+}
+
+void vx_spawn_tasks_dyn(int num_tasks, int chunk_size, int* counter, vx_spawn_tasks_cb callback, void * arg) {
+  spawn_dyn_tasks(num_tasks, chunk_size, counter, 1, callback, arg);
+}
+
+void vx_spawn_tasks_steal(int num_tasks, int chunk_size, int* counters, vx_spawn_tasks_cb callback, void * arg) {
+  spawn_dyn_tasks(num_tasks, chunk_size, counters, vx_num_cores(), callback, arg);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 typedef struct {
 	vx_spawn_task_groups_cb callback;
 	void* arg;
@@ -245,10 +382,9 @@ void vx_spawn_task_groups(int num_groups, int group_size, vx_spawn_task_groups_c
   if (core_id >= active_cores)
     return;
 
-  int total_groups_per_core = num_groups / active_cores;
-  int remaining_groups_per_core = num_groups - active_cores * total_groups_per_core;
-  if (core_id < remaining_groups_per_core)
-    total_groups_per_core++;
+  int base_groups_per_core = num_groups / active_cores;
+  int remaining_groups_per_core = num_groups - active_cores * base_groups_per_core;
+  int total_groups_per_core = base_groups_per_core + (core_id < remaining_groups_per_core);
 
   // calculate number of warps to activate
   int groups_per_core = warps_per_core / warps_per_group;
@@ -262,7 +398,7 @@ void vx_spawn_task_groups(int num_groups, int group_size, vx_spawn_task_groups_c
   }
 
   // calculate offsets for group distribution
-  int group_offset = core_id * total_groups_per_core + MIN(core_id, remaining_groups_per_core);
+  int group_offset = core_id * base_groups_per_core + MIN(core_id, remaining_groups_per_core);
 
   // prepare scheduler arguments
   wspawn_task_groups_args_t wspawn_args = {
@@ -287,6 +423,174 @@ void vx_spawn_task_groups(int num_groups, int group_size, vx_spawn_task_groups_c
   vx_wspawn(1, 0);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+__thread dim3_t blockIdx;
+__thread dim3_t threadIdx;
+__thread dim3_t globalIdx;
+dim3_t gridDim;
+dim3_t blockDim;
+
+__thread uint32_t __local_group_id;
+__thread void* __local_group_mem;
+uint32_t __warps_per_group;
+
+typedef struct {
+	vx_spawn_threads_cb callback;
+	void* arg;
+	int group_offset;
+	int num_groups;
+	int groups_per_core;
+	int warps_per_group;
+	int remaining_mask;
+	uint32_t local_mem_size;
+} wspawn_threads_args_t;
+
+static void __attribute__ ((noinline)) process_threads() {
+  wspawn_threads_args_t* targs = (wspawn_threads_args_t*)csr_read(VX_CSR_MSCRATCH);
+
+  int warps_per_group = targs->warps_per_group;
+  int groups_per_core = targs->groups_per_core;
+
+  int threads_per_warp = vx_num_threads();
+  int warp_id = vx_warp_id();
+  int thread_id = vx_thread_id();
+
+  int local_group_id = warp_id / warps_per_group;
+  int group_warp_id = warp_id - local_group_id * warps_per_group;
+  int local_task_id = group_warp_id * threads_per_warp + thread_id;
+
+  // thread and group-slot state stays fixed across the blocks of this slot
+  threadIdx.x = local_task_id % blockDim.x;
+  threadIdx.y = (local_task_id / blockDim.x) % blockDim.y;
+  threadIdx.z = local_task_id / (blockDim.x * blockDim.y);
+  __local_group_id = local_group_id;
+  __local_group_mem = (void*)((size_t)LMEM_BASE_ADDR + local_group_id * targs->local_mem_size);
+
+  int start_group = targs->group_offset + local_group_id;
+  int end_group = targs->group_offset + targs->num_groups;
+
+  vx_spawn_threads_cb callback = targs->callback;
+  void* arg = targs->arg;
+
+  for (int group_id = start_group; group_id < end_group; group_id += groups_per_core) {
+    blockIdx.x = group_id % gridDim.x;
+    blockIdx.y = (group_id / gridDim.x) % gridDim.y;
+    blockIdx.z = group_id / (gridDim.x * gridDim.y);
+    globalIdx.x = blockIdx.x * blockDim.x + threadIdx.x;
+    globalIdx.y = blockIdx.y * blockDim.y + threadIdx.y;
+    globalIdx.z = blockIdx.z * blockDim.z + threadIdx.z;
+    callback(arg);
+  }
+}
+
+static void __attribute__ ((noinline)) process_threads_stub() {
+  wspawn_threads_args_t* targs = (wspawn_threads_args_t*)csr_read(VX_CSR_MSCRATCH);
+  int warps_per_group = targs->warps_per_group;
+  int remaining_mask = targs->remaining_mask;
+  int warp_id = vx_warp_id();
+  int group_warp_id = warp_id % warps_per_group;
+  int threads_mask = (group_warp_id == warps_per_group-1) ? remaining_mask : -1;
+
+  // activate threads
+  vx_tmc(threads_mask);
+
+  // process all blocks
+  process_threads();
+
+  // disable all warps except warp0
+  vx_tmc(0 == vx_warp_id());
+}
+
+void vx_spawn_threads(uint32_t dimension, const uint32_t* grid_dim, const uint32_t* block_dim, uint32_t local_mem_size, vx_spawn_threads_cb callback, void * arg) {
+  // device specifications
+  int num_cores = vx_num_cores();
+  int warps_per_core = vx_num_warps();
+  int threads_per_warp = vx_num_threads();
+  int core_id = vx_core_id();
+
+  // unused dimensions default to one
+  dim3_t grid = {1, 1, 1}, block = {1, 1, 1};
+  if (dimension > 0) { grid.x = grid_dim[0]; block.x = block_dim[0]; }
+  if (dimension > 1) { grid.y = grid_dim[1]; block.y = block_dim[1]; }
+  if (dimension > 2) { grid.z = grid_dim[2]; block.z = block_dim[2]; }
+
+  // check group size
+  int threads_per_core = warps_per_core * threads_per_warp;
+  int group_size = block.x * block.y * block.z;
+  if (group_size > threads_per_core) {
+    vx_printf("error: block size > threads_per_core (%d)\n", threads_per_core);
+    return;
+  }
+
+  int warps_per_group = group_size / threads_per_warp;
+  int remaining_threads = group_size - warps_per_group * threads_per_warp;
+  int remaining_mask = -1;
+  if (remaining_threads != 0) {
+    remaining_mask = (1 << remaining_threads) - 1;
+    warps_per_group++;
+  }
+
+  // resident blocks per core, bounded by the warps, the barriers and the local memory
+  int groups_per_core = warps_per_core / warps_per_group;
+  if (warps_per_group > 1) {
+    groups_per_core = MIN(groups_per_core, vx_num_barriers());
+  }
+  if (local_mem_size != 0) {
+    int lmem_groups = (1 << LMEM_LOG_SIZE) / local_mem_size;
+    if (lmem_groups == 0) {
+      vx_printf("error: block local memory > local memory size (%d)\n", (1 << LMEM_LOG_SIZE));
+      return;
+    }
+    groups_per_core = MIN(groups_per_core, lmem_groups);
+  }
+
+  int num_groups = grid.x * grid.y * grid.z;
+  int needed_cores = (num_groups + groups_per_core - 1) / groups_per_core;
+  int active_cores = MIN(needed_cores, num_cores);
+
+  // only active cores participate
+  if (core_id >= active_cores)
+    return;
+
+  int base_groups_per_core = num_groups / active_cores;
+  int remaining_groups_per_core = num_groups - active_cores * base_groups_per_core;
+  int total_groups_per_core = base_groups_per_core + (core_id < remaining_groups_per_core);
+
+  // calculate number of warps to activate
+  int active_warps = MIN(total_groups_per_core, groups_per_core) * warps_per_group;
+
+  // calculate offsets for group distribution
+  int group_offset = core_id * base_groups_per_core + MIN(core_id, remaining_groups_per_core);
+
+  // launch shape shared by all threads
+  gridDim = grid;
+  blockDim = block;
+  __warps_per_group = warps_per_group;
+
+  // prepare scheduler arguments
+  wspawn_threads_args_t wspawn_args = {
+    callback,
+    arg,
+    group_offset,
+    total_groups_per_core,
+    groups_per_core,
+    warps_per_group,
+    remaining_mask,
+    local_mem_size
+  };
+  csr_write(VX_CSR_MSCRATCH, &wspawn_args);
+
+  // execute callback on other warps
+  vx_wspawn(active_warps, process_threads_stub);
+
+  // execute callback on warp0
+  process_threads_stub();
+
+  // wait for spawned tasks to complete
+  vx_wspawn(1, 0);
+}
+
 #ifdef __cplusplus
 }
 #endif
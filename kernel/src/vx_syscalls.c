@@ -15,6 +15,7 @@
 #include <newlib.h>
 #include <unistd.h>
 #include <vx_intrinsics.h>
+#include <vx_memory.h>
 #include <vx_print.h>
 #include <string.h>
 
@@ -34,9 +35,16 @@ int _open(const char *name, int flags, int mode) { return -1; }
 
 int _read(int file, char *ptr, int len) { return -1; }
 
+extern void* __vx_heap_bump(size_t size);
+
+// newlib's malloc grows from the device heap, it is not thread-safe (see vx_malloc)
 caddr_t _sbrk(int incr) {
-  __asm__ __volatile__("ebreak");
-  return 0;
+  if (incr < 0)
+    return (caddr_t)-1;
+  void* ptr = __vx_heap_bump((incr + 7) & ~7);
+  if (ptr == NULL)
+    return (caddr_t)-1;
+  return (caddr_t)ptr;
 }
 
 int _write(int file, char *ptr, int len) {
@@ -61,8 +69,8 @@ void __init_tls(void) {
 
   // TLS memory initialization
   register char *__thread_self __asm__ ("tp");
-  memcpy(__thread_self, __tdata_start, (size_t)__tdata_size);
-  memset(__thread_self + (size_t)__tbss_offset, 0, (size_t)__tbss_size);
+  vx_memcpy(__thread_self, __tdata_start, (size_t)__tdata_size);
+  vx_memset(__thread_self + (size_t)__tbss_offset, 0, (size_t)__tbss_size);
 }
 
 #ifdef HAVE_INITFINI_ARRAY
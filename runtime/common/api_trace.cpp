@@ -0,0 +1,157 @@
+// Copyright © 2019-2023
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "api_trace.h"
+#include <VX_types.h>
+#include <nlohmann_json.hpp>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <unordered_map>
+#include <sstream>
+
+using json = nlohmann::json;
+
+class ApiTracer {
+public:
+  ApiTracer() : enabled_(false) {
+    auto path_s = getenv("VORTEX_API_TRACE");
+    if (path_s && path_s[0] != '\0') {
+      path_ = path_s;
+      enabled_ = true;
+    }
+    start_ = std::chrono::steady_clock::now();
+    events_ = json::array();
+  }
+
+  ~ApiTracer() {
+    if (enabled_) {
+      this->flush();
+    }
+  }
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  // elapsed microseconds since startup
+  double now() const {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    return std::chrono::duration<double, std::micro>(elapsed).count();
+  }
+
+  void record(const char* name,
+              const void* handle,
+              uint64_t bytes,
+              uint64_t cycles,
+              double start_time,
+              double end_time) {
+    std::stringstream ss;
+    ss << handle;
+
+    json args;
+    args["handle"] = ss.str();
+    if (bytes != 0) {
+      args["bytes"] = bytes;
+    }
+    if (cycles != 0) {
+      args["cycles"] = cycles;
+    }
+
+    json event;
+    event["name"] = name;
+    event["cat"]  = "api";
+    event["ph"]   = "X";
+    event["ts"]   = start_time;
+    event["dur"]  = end_time - start_time;
+    event["pid"]  = 0;
+    event["args"] = args;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    event["tid"] = this->thread_index(std::this_thread::get_id());
+    events_.push_back(event);
+  }
+
+private:
+
+  uint32_t thread_index(std::thread::id tid) {
+    auto it = threads_.find(tid);
+    if (it != threads_.end())
+      return it->second;
+    uint32_t index = threads_.size();
+    threads_[tid] = index;
+    return index;
+  }
+
+  void flush() {
+    json trace;
+    trace["traceEvents"] = events_;
+    trace["displayTimeUnit"] = "ms";
+    std::ofstream ofs(path_);
+    if (!ofs.is_open()) {
+      std::cerr << "[VXDRV] Error: failed to open API trace file: " << path_ << std::endl;
+      return;
+    }
+    ofs << trace.dump() << std::endl;
+  }
+
+  std::string path_;
+  bool enabled_;
+  std::chrono::steady_clock::time_point start_;
+  std::mutex mutex_;
+  json events_;
+  std::unordered_map<std::thread::id, uint32_t> threads_;
+};
+
+static ApiTracer gApiTracer;
+
+// calls issued by the tracer itself are not recorded
+static thread_local bool t_api_trace_muted = false;
+
+///////////////////////////////////////////////////////////////////////////////
+
+ApiTrace::ApiTrace(const char* name, const void* handle, uint64_t bytes)
+  : name_(name)
+  , handle_(handle)
+  , bytes_(bytes)
+  , cycles_(0)
+  , start_time_(0)
+  , end_time_(0)
+  , active_(gApiTracer.enabled() && !t_api_trace_muted) {
+  if (active_) {
+    start_time_ = gApiTracer.now();
+  }
+}
+
+ApiTrace::~ApiTrace() {
+  if (!active_)
+    return;
+  if (end_time_ == 0) {
+    end_time_ = gApiTracer.now();
+  }
+  gApiTracer.record(name_, handle_, bytes_, cycles_, start_time_, end_time_);
+}
+
+void ApiTrace::query_cycles(vx_device_h hdevice) {
+  if (!active_)
+    return;
+  // exclude the counter readback from the call duration
+  end_time_ = gApiTracer.now();
+  t_api_trace_muted = true;
+  uint64_t cycles;
+  if (0 == vx_mpm_query(hdevice, VX_CSR_MCYCLE, 0, &cycles)) {
+    cycles_ = cycles;
+  }
+  t_api_trace_muted = false;
+}
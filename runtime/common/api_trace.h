@@ -0,0 +1,45 @@
+// Copyright © 2019-2023
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <vortex.h>
+#include <cstdint>
+
+// Runtime API timeline tracing.
+// Setting VORTEX_API_TRACE=<file.json> records every vortex.h call with its
+// host timestamps, byte count and kernel cycles, and writes them at exit
+// as Chrome trace events (chrome://tracing or ui.perfetto.dev).
+
+class ApiTrace {
+public:
+  ApiTrace(const char* name, const void* handle, uint64_t bytes);
+  ~ApiTrace();
+
+  // attach the cycle count of the last kernel run on the device
+  void query_cycles(vx_device_h hdevice);
+
+private:
+  const char* name_;
+  const void* handle_;
+  uint64_t bytes_;
+  uint64_t cycles_;
+  double start_time_;
+  double end_time_;
+  bool active_;
+};
+
+#define API_TRACE(handle, bytes) \
+  ApiTrace _api_trace(__func__, handle, bytes)
+
+#define API_TRACE_CYCLES(hdevice) \
+  _api_trace.query_cycles(hdevice)
@@ -0,0 +1,77 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vortex.h>
+#include <cstdint>
+#include <vector>
+
+// Kernel graphs.
+// A graph is captured once with the vx_graph_* utility calls and replayed
+// by the backend's vx_graph_launch. Nodes keep the host pointers they were
+// captured with, so a replay picks up whatever the host wrote there since.
+
+struct vx_graph_node_t {
+  enum type_t {
+    COPY_TO_DEV,
+    COPY_FROM_DEV,
+    START
+  };
+  type_t   type;
+  uint64_t dev_addr;  // copy address or kernel address
+  uint64_t arg_addr;  // kernel arguments address
+  uint64_t size;
+  void*    host_ptr;
+};
+
+struct vx_graph {
+  vx_device_h device;
+  std::vector<vx_graph_node_t> nodes;
+};
+
+// check that all copy nodes fit in the device address space
+inline int graph_validate(const vx_graph* graph, uint64_t mem_size) {
+  for (auto& node : graph->nodes) {
+    if (node.type != vx_graph_node_t::START
+     && (node.dev_addr + node.size) > mem_size)
+      return -1;
+  }
+  return 0;
+}
+
+// replay the nodes in order on a backend device,
+// each kernel completes before the following node executes
+template <typename Device>
+int graph_execute(Device* device, const std::vector<vx_graph_node_t>& nodes) {
+  for (auto& node : nodes) {
+    int err = 0;
+    switch (node.type) {
+    case vx_graph_node_t::COPY_TO_DEV:
+      err = device->upload(node.dev_addr, node.host_ptr, node.size);
+      break;
+    case vx_graph_node_t::COPY_FROM_DEV:
+      err = device->download(node.host_ptr, node.dev_addr, node.size);
+      break;
+    case vx_graph_node_t::START:
+      err = device->start(node.dev_addr, node.arg_addr);
+      if (err == 0) {
+        err = device->ready_wait(VX_MAX_TIMEOUT);
+      }
+      break;
+    }
+    if (err != 0)
+      return err;
+  }
+  return 0;
+}
@@ -35,6 +35,11 @@ public:
     {}
 
     ~MemoryAllocator() {
+        this->reset();
+    }
+
+    // release all allocations
+    void reset() {
         // Free allocated pages
         page_t* currPage = pages_;
         while (currPage) {
@@ -42,6 +47,8 @@ public:
             delete currPage;
             currPage = nextPage;
         }
+        pages_ = nullptr;
+        allocated_ = 0;
     }
 
     uint32_t baseAddress() const {
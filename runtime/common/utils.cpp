@@ -12,12 +12,19 @@
 // limitations under the License.
 
 #include "utils.h"
+#include "api_trace.h"
+#include "graph.h"
 #include <iostream>
 #include <fstream>
 #include <list>
 #include <cstring>
 #include <vector>
 #include <unordered_map>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <mutex>
 #include <vortex.h>
 #include <assert.h>
 
@@ -44,7 +51,7 @@ bool is_aligned(uint64_t addr, uint64_t alignment) {
 
 class AutoPerfDump {
 public:
-  AutoPerfDump() : perf_class_(0) {
+  AutoPerfDump() : next_id_(0), perf_class_(0) {
     auto profiling_s = getenv("VORTEX_PROFILING");
     if (profiling_s) {
       perf_class_ = std::atoi(profiling_s);
@@ -54,22 +61,26 @@ public:
   ~AutoPerfDump() {}
 
   int add(vx_device_h hdevice) {
-    int ret = devices_.size();
+    std::lock_guard<std::mutex> lock(mutex_);
+    // ids are never reused, devices can be closed in any order
+    int ret = next_id_++;
     devices_[ret] = hdevice;
     return ret;
   }
 
   void remove(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
     devices_.erase(id);
   }
 
   void begin(int id) {
-    auto device = devices_.at(id);
+    // the device calls below must not run under the registry lock
+    auto device = this->get_device(id);
     vx_dcr_write(device, VX_DCR_BASE_MPM_CLASS, perf_class_);
   }
 
   void end(int id) {
-    auto device = devices_.at(id);
+    auto device = this->get_device(id);
     vx_dump_perf(device, stdout);
   }
 
@@ -78,7 +89,14 @@ public:
   }
 
 private:
+  vx_device_h get_device(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return devices_.at(id);
+  }
+
   std::unordered_map<int, vx_device_h> devices_;
+  std::mutex mutex_;
+  int next_id_;
   int perf_class_;
 };
 
@@ -145,6 +163,8 @@ int dcr_initialize(vx_device_h hdevice) {
 ///////////////////////////////////////////////////////////////////////////////
 
 extern int vx_upload_kernel_bytes(vx_device_h hdevice, const void* content, uint64_t size, vx_buffer_h* hbuffer) {
+  API_TRACE(hdevice, size);
+
   if (nullptr == hdevice || nullptr == content || size <= 8 || nullptr == hbuffer)
     return -1;
 
@@ -189,6 +209,8 @@ extern int vx_upload_kernel_bytes(vx_device_h hdevice, const void* content, uint
 }
 
 extern int vx_upload_kernel_file(vx_device_h hdevice, const char* filename, vx_buffer_h* hbuffer) {
+  API_TRACE(hdevice, 0);
+
   if (nullptr == hdevice || nullptr == filename || nullptr == hbuffer)
     return -1;
 
@@ -213,7 +235,95 @@ extern int vx_upload_kernel_file(vx_device_h hdevice, const char* filename, vx_b
   return 0;
 }
 
+// warm start header layout, see kernel/src/vx_start.S
+#define WARM_START_MAGIC    0x53575856 // "VXWS"
+#define WARM_START_OFFSET   1 // in words
+
+extern int vx_kernel_warm_start(vx_buffer_h hkernel, int enable) {
+  API_TRACE(hkernel, 0);
+
+  if (nullptr == hkernel)
+    return -1;
+
+  // patch the header's first cache block
+  uint32_t header[CACHE_BLOCK_SIZE / sizeof(uint32_t)];
+  RT_CHECK(vx_copy_from_dev(header, hkernel, 0, CACHE_BLOCK_SIZE), {
+    return _ret;
+  });
+
+  if (header[WARM_START_OFFSET] != WARM_START_MAGIC) {
+    printf("Error: kernel image does not support warm start!\n");
+    return -1;
+  }
+
+  header[WARM_START_OFFSET + 1] = enable ? 1 : 0;
+
+  RT_CHECK(vx_copy_to_dev(hkernel, header, 0, CACHE_BLOCK_SIZE), {
+    return _ret;
+  });
+
+  return 0;
+}
+
+// device heap descriptor in the startup header, see kernel/src/vx_start.S
+#define HEAP_BASE_OFFSET    4 // in words
+#define HEAP_SIZE_OFFSET    6 // in words
+
+extern int vx_kernel_heap(vx_device_h hdevice, vx_buffer_h hkernel, uint64_t size, vx_buffer_h* hheap) {
+  API_TRACE(hdevice, 0);
+
+  if (nullptr == hdevice || nullptr == hkernel || (size != 0 && nullptr == hheap))
+    return -1;
+
+  uint32_t header[CACHE_BLOCK_SIZE / sizeof(uint32_t)];
+  RT_CHECK(vx_copy_from_dev(header, hkernel, 0, CACHE_BLOCK_SIZE), {
+    return _ret;
+  });
+
+  if (header[WARM_START_OFFSET] != WARM_START_MAGIC) {
+    printf("Error: kernel image does not support a device heap!\n");
+    return -1;
+  }
+
+  // a zero size detaches the heap
+  uint64_t address = 0;
+  vx_buffer_h _hheap = nullptr;
+  if (size != 0) {
+    RT_CHECK(vx_mem_alloc(hdevice, size, VX_MEM_READ_WRITE, &_hheap), {
+      return _ret;
+    });
+    RT_CHECK(vx_mem_address(_hheap, &address), {
+      vx_mem_free(_hheap);
+      return _ret;
+    });
+  }
+
+  header[HEAP_BASE_OFFSET + 0] = address & 0xffffffff;
+  header[HEAP_BASE_OFFSET + 1] = address >> 32;
+  header[HEAP_SIZE_OFFSET + 0] = size & 0xffffffff;
+  header[HEAP_SIZE_OFFSET + 1] = size >> 32;
+
+  // the allocator state lives in BSS/TLS and points into the previous heap,
+  // so the next launch must run the startup initialization again
+  header[WARM_START_OFFSET + 1] = 0;
+
+  RT_CHECK(vx_copy_to_dev(hkernel, header, 0, CACHE_BLOCK_SIZE), {
+    if (_hheap) {
+      vx_mem_free(_hheap);
+    }
+    return _ret;
+  });
+
+  if (hheap) {
+    *hheap = _hheap;
+  }
+
+  return 0;
+}
+
 extern int vx_upload_bytes(vx_device_h hdevice, const void* content, uint64_t size, vx_buffer_h* hbuffer) {
+  API_TRACE(hdevice, size);
+
   if (nullptr == hdevice || nullptr == content || 0 == size || nullptr == hbuffer)
     return -1;
 
@@ -234,6 +344,8 @@ extern int vx_upload_bytes(vx_device_h hdevice, const void* content, uint64_t si
 }
 
 extern int vx_upload_file(vx_device_h hdevice, const char* filename, vx_buffer_h* hbuffer) {
+  API_TRACE(hdevice, 0);
+
   if (nullptr == hdevice || nullptr == filename || nullptr == hbuffer)
     return -1;
 
@@ -260,7 +372,378 @@ extern int vx_upload_file(vx_device_h hdevice, const char* filename, vx_buffer_h
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// mailbox layout, see kernel/include/vx_mailbox.h
+// the device reads the counters offset from the header
+#define MAILBOX_DONE_OFFSET CACHE_BLOCK_SIZE
+
+struct vx_mailbox_header_t {
+  uint32_t head;
+  uint32_t stop;
+  uint32_t doorbell;
+  uint32_t capacity;
+  uint32_t desc_stride;
+  uint32_t desc_offset;
+  uint32_t done_offset;
+};
+
+struct vx_mailbox {
+  vx_buffer_h buffer;
+  uint32_t num_cores;
+  uint32_t desc_size;
+  uint64_t submitted;
+  // host-owned cache block
+  union {
+    vx_mailbox_header_t header;
+    uint8_t header_block[CACHE_BLOCK_SIZE];
+  };
+  std::vector<uint8_t> desc_block;
+  std::vector<uint32_t> done;
+};
+
+static int mailbox_update_header(vx_mailbox* mailbox) {
+  ++mailbox->header.doorbell;
+  return vx_copy_to_dev(mailbox->buffer, mailbox->header_block, 0, CACHE_BLOCK_SIZE);
+}
+
+// return the number of descriptors completed by all cores
+static int mailbox_query_done(vx_mailbox* mailbox, uint64_t* completed) {
+  auto done_size = mailbox->done.size() * sizeof(uint32_t);
+  RT_CHECK(vx_copy_from_dev(mailbox->done.data(), mailbox->buffer, MAILBOX_DONE_OFFSET, done_size), {
+    return _ret;
+  });
+  // device counters are 32-bit, extend them relative to the submitted count
+  uint64_t min_done = mailbox->submitted;
+  for (uint32_t i = 0; i < mailbox->num_cores; ++i) {
+    uint32_t pending = uint32_t(mailbox->submitted) - mailbox->done.at(i);
+    min_done = std::min<uint64_t>(min_done, mailbox->submitted - pending);
+  }
+  *completed = min_done;
+  return 0;
+}
+
+extern int vx_mailbox_create(vx_device_h hdevice, uint32_t capacity, uint32_t desc_size, vx_mailbox_h* hmailbox) {
+  API_TRACE(hdevice, 0);
+
+  if (nullptr == hdevice || 0 == capacity || 0 == desc_size || nullptr == hmailbox)
+    return -1;
+
+  // the device indexes the ring with a 32-bit counter and the host with a 64-bit one,
+  // they only select the same entry after wrapping if the capacity is a power of two
+  if (0 != (capacity & (capacity - 1))) {
+    printf("Error: mailbox capacity %d is not a power of two!\n", capacity);
+    return -1;
+  }
+
+  uint64_t num_cores;
+  RT_CHECK(vx_dev_caps(hdevice, VX_CAPS_NUM_CORES, &num_cores), {
+    return _ret;
+  });
+
+  auto done_size = aligned_size(num_cores * sizeof(uint32_t), CACHE_BLOCK_SIZE);
+  auto desc_stride = aligned_size(desc_size, CACHE_BLOCK_SIZE);
+  auto desc_offset = MAILBOX_DONE_OFFSET + done_size;
+  auto total_size = desc_offset + capacity * desc_stride;
+
+  vx_buffer_h buffer;
+  RT_CHECK(vx_mem_alloc(hdevice, total_size, VX_MEM_READ_WRITE, &buffer), {
+    return _ret;
+  });
+
+  auto mailbox = new vx_mailbox();
+  mailbox->buffer = buffer;
+  mailbox->num_cores = num_cores;
+  mailbox->desc_size = desc_size;
+  mailbox->submitted = 0;
+  memset(mailbox->header_block, 0, CACHE_BLOCK_SIZE);
+  mailbox->header.capacity = capacity;
+  mailbox->header.desc_stride = desc_stride;
+  mailbox->header.desc_offset = desc_offset;
+  mailbox->header.done_offset = MAILBOX_DONE_OFFSET;
+  mailbox->desc_block.resize(desc_stride, 0);
+  mailbox->done.resize(done_size / sizeof(uint32_t), 0);
+
+  // clear completion counters
+  RT_CHECK(vx_copy_to_dev(buffer, mailbox->done.data(), MAILBOX_DONE_OFFSET, done_size), {
+    vx_mailbox_destroy(mailbox);
+    return _ret;
+  });
+
+  RT_CHECK(mailbox_update_header(mailbox), {
+    vx_mailbox_destroy(mailbox);
+    return _ret;
+  });
+
+  *hmailbox = mailbox;
+
+  return 0;
+}
+
+extern int vx_mailbox_address(vx_mailbox_h hmailbox, uint64_t* address) {
+  API_TRACE(hmailbox, 0);
+
+  if (nullptr == hmailbox || nullptr == address)
+    return -1;
+  auto mailbox = (vx_mailbox*)hmailbox;
+  return vx_mem_address(mailbox->buffer, address);
+}
+
+extern int vx_mailbox_submit(vx_mailbox_h hmailbox, const void* desc, uint64_t* ticket) {
+  API_TRACE(hmailbox, 0);
+
+  if (nullptr == hmailbox || nullptr == desc)
+    return -1;
+
+  auto mailbox = (vx_mailbox*)hmailbox;
+  if (mailbox->header.stop)
+    return -1;
+
+  // wait for a free ring entry
+  uint64_t completed;
+  for (;;) {
+    RT_CHECK(mailbox_query_done(mailbox, &completed), {
+      return _ret;
+    });
+    if ((mailbox->submitted - completed) < mailbox->header.capacity)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // write the descriptor before publishing it
+  auto index = mailbox->submitted % mailbox->header.capacity;
+  memcpy(mailbox->desc_block.data(), desc, mailbox->desc_size);
+  RT_CHECK(vx_copy_to_dev(mailbox->buffer, mailbox->desc_block.data(), mailbox->header.desc_offset + index * mailbox->header.desc_stride, mailbox->header.desc_stride), {
+    return _ret;
+  });
+
+  ++mailbox->submitted;
+  mailbox->header.head = uint32_t(mailbox->submitted);
+  RT_CHECK(mailbox_update_header(mailbox), {
+    return _ret;
+  });
+
+  if (ticket) {
+    *ticket = mailbox->submitted;
+  }
+
+  return 0;
+}
+
+extern int vx_mailbox_wait(vx_mailbox_h hmailbox, uint64_t ticket, uint64_t timeout) {
+  API_TRACE(hmailbox, 0);
+
+  if (nullptr == hmailbox)
+    return -1;
+
+  auto mailbox = (vx_mailbox*)hmailbox;
+  if (ticket > mailbox->submitted)
+    return -1;
+
+  for (;;) {
+    uint64_t completed;
+    RT_CHECK(mailbox_query_done(mailbox, &completed), {
+      return _ret;
+    });
+    if (completed >= ticket)
+      break;
+    if (0 == timeout--)
+      return -1;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  return 0;
+}
+
+extern int vx_mailbox_stop(vx_mailbox_h hmailbox) {
+  API_TRACE(hmailbox, 0);
+
+  if (nullptr == hmailbox)
+    return -1;
+  auto mailbox = (vx_mailbox*)hmailbox;
+  mailbox->header.stop = 1;
+  return mailbox_update_header(mailbox);
+}
+
+extern int vx_mailbox_destroy(vx_mailbox_h hmailbox) {
+  API_TRACE(hmailbox, 0);
+
+  if (nullptr == hmailbox)
+    return -1;
+  auto mailbox = (vx_mailbox*)hmailbox;
+  vx_mem_free(mailbox->buffer);
+  delete mailbox;
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct vx_arg_ring {
+  vx_device_h hdevice;
+  uint32_t slot_size;
+  uint32_t next;
+  std::vector<vx_buffer_h> slots;
+};
+
+extern int vx_arg_ring_create(vx_device_h hdevice, uint32_t num_slots, uint32_t slot_size, vx_arg_ring_h* hring) {
+  API_TRACE(hdevice, 0);
+
+  if (nullptr == hdevice || 0 == slot_size || nullptr == hring)
+    return -1;
+
+  // a launch copies into its slot while the previous one may still run,
+  // so at least two slots are needed to not overwrite its arguments
+  if (num_slots < 2) {
+    printf("Error: argument ring needs at least 2 slots!\n");
+    return -1;
+  }
+
+  auto ring = new vx_arg_ring();
+  ring->hdevice = hdevice;
+  ring->slot_size = aligned_size(slot_size, CACHE_BLOCK_SIZE);
+  ring->next = 0;
+
+  // allocate all slots upfront, launches only pay for the argument copy
+  for (uint32_t i = 0; i < num_slots; ++i) {
+    vx_buffer_h buffer;
+    RT_CHECK(vx_mem_alloc(hdevice, ring->slot_size, VX_MEM_READ, &buffer), {
+      vx_arg_ring_destroy(ring);
+      return _ret;
+    });
+    ring->slots.push_back(buffer);
+  }
+
+  *hring = ring;
+
+  return 0;
+}
+
+extern int vx_arg_ring_start(vx_arg_ring_h hring, vx_buffer_h hkernel, const void* args, uint32_t size) {
+  API_TRACE(hring, size);
+
+  if (nullptr == hring || nullptr == hkernel || nullptr == args || 0 == size)
+    return -1;
+
+  auto ring = (vx_arg_ring*)hring;
+  if (size > ring->slot_size) {
+    printf("Error: kernel arguments exceed the ring slot size (%d > %d)!\n", size, ring->slot_size);
+    return -1;
+  }
+
+  // vx_start waits for the prior launch, so the copy below can happen while
+  // it still runs. Backends serialize device memory copies with a running
+  // kernel, and rotating over at least two slots keeps the copy off the
+  // arguments still in use.
+  auto buffer = ring->slots.at(ring->next);
+  ring->next = (ring->next + 1) % ring->slots.size();
+
+  RT_CHECK(vx_copy_to_dev(buffer, args, 0, size), {
+    return _ret;
+  });
+
+  RT_CHECK(vx_start(ring->hdevice, hkernel, buffer), {
+    return _ret;
+  });
+
+  return 0;
+}
+
+extern int vx_arg_ring_destroy(vx_arg_ring_h hring) {
+  API_TRACE(hring, 0);
+
+  if (nullptr == hring)
+    return -1;
+  auto ring = (vx_arg_ring*)hring;
+  for (auto buffer : ring->slots) {
+    vx_mem_free(buffer);
+  }
+  delete ring;
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern int vx_graph_create(vx_device_h hdevice, vx_graph_h* hgraph) {
+  API_TRACE(hdevice, 0);
+
+  if (nullptr == hdevice || nullptr == hgraph)
+    return -1;
+
+  auto graph = new vx_graph();
+  graph->device = hdevice;
+
+  *hgraph = graph;
+
+  return 0;
+}
+
+extern int vx_graph_copy_to_dev(vx_graph_h hgraph, vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size) {
+  API_TRACE(hgraph, size);
+
+  if (nullptr == hgraph || nullptr == hbuffer || nullptr == host_ptr || 0 == size)
+    return -1;
+
+  uint64_t dev_addr;
+  RT_CHECK(vx_mem_address(hbuffer, &dev_addr), {
+    return _ret;
+  });
+
+  auto graph = (vx_graph*)hgraph;
+  graph->nodes.push_back({vx_graph_node_t::COPY_TO_DEV, dev_addr + dst_offset, 0, size, const_cast<void*>(host_ptr)});
+
+  return 0;
+}
+
+extern int vx_graph_copy_from_dev(vx_graph_h hgraph, void* host_ptr, vx_buffer_h hbuffer, uint64_t src_offset, uint64_t size) {
+  API_TRACE(hgraph, size);
+
+  if (nullptr == hgraph || nullptr == hbuffer || nullptr == host_ptr || 0 == size)
+    return -1;
+
+  uint64_t dev_addr;
+  RT_CHECK(vx_mem_address(hbuffer, &dev_addr), {
+    return _ret;
+  });
+
+  auto graph = (vx_graph*)hgraph;
+  graph->nodes.push_back({vx_graph_node_t::COPY_FROM_DEV, dev_addr + src_offset, 0, size, host_ptr});
+
+  return 0;
+}
+
+extern int vx_graph_start(vx_graph_h hgraph, vx_buffer_h hkernel, vx_buffer_h harguments) {
+  API_TRACE(hgraph, 0);
+
+  if (nullptr == hgraph || nullptr == hkernel || nullptr == harguments)
+    return -1;
+
+  uint64_t krnl_addr, args_addr;
+  RT_CHECK(vx_mem_address(hkernel, &krnl_addr), {
+    return _ret;
+  });
+  RT_CHECK(vx_mem_address(harguments, &args_addr), {
+    return _ret;
+  });
+
+  auto graph = (vx_graph*)hgraph;
+  graph->nodes.push_back({vx_graph_node_t::START, krnl_addr, args_addr, 0, nullptr});
+
+  return 0;
+}
+
+extern int vx_graph_destroy(vx_graph_h hgraph) {
+  API_TRACE(hgraph, 0);
+
+  if (nullptr == hgraph)
+    return -1;
+  auto graph = (vx_graph*)hgraph;
+  delete graph;
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
+  API_TRACE(hdevice, 0);
+
   uint64_t total_instrs = 0;
   uint64_t total_cycles = 0;
   uint64_t max_cycles = 0;
@@ -738,7 +1221,116 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
   return 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// profiling layout, see kernel/include/vx_prof.h
+struct vx_prof_record_t {
+  uint32_t id;
+  uint32_t reserved;
+  uint32_t cycles;
+  uint32_t instrs;
+};
+
+struct vx_prof_warp_t {
+  uint32_t count;
+  uint32_t reserved[3];
+  uint32_t start_cycles[PROF_MAX_REGIONS];
+  uint32_t start_instrs[PROF_MAX_REGIONS];
+  vx_prof_record_t ring[PROF_RING_SIZE];
+};
+
+static_assert(sizeof(vx_prof_warp_t) == PROF_WARP_SIZE, "invalid profiling layout");
+
+struct prof_stats_t {
+  uint64_t count = 0;
+  uint64_t cycles = 0;
+  uint64_t instrs = 0;
+  uint32_t min_cycles = UINT32_MAX;
+  uint32_t max_cycles = 0;
+
+  void add(const vx_prof_record_t& record) {
+    ++count;
+    cycles += record.cycles;
+    instrs += record.instrs;
+    min_cycles = std::min(min_cycles, record.cycles);
+    max_cycles = std::max(max_cycles, record.cycles);
+  }
+};
+
+extern int vx_dump_prof(vx_device_h hdevice, FILE* stream) {
+  API_TRACE(hdevice, 0);
+
+  uint64_t num_cores, num_warps;
+  RT_CHECK(vx_dev_caps(hdevice, VX_CAPS_NUM_CORES, &num_cores), {
+    return _ret;
+  });
+  RT_CHECK(vx_dev_caps(hdevice, VX_CAPS_NUM_WARPS, &num_warps), {
+    return _ret;
+  });
+
+  // download the per-warp rings, the device only profiles the first PROF_MAX_WARPS warps
+  std::vector<vx_prof_warp_t> warps(std::min<uint64_t>(num_cores * num_warps, PROF_MAX_WARPS));
+  uint64_t size = warps.size() * sizeof(vx_prof_warp_t);
+  vx_buffer_h buffer;
+  RT_CHECK(vx_mem_reserve(hdevice, IO_PROF_ADDR, size, VX_MEM_READ, &buffer), {
+    return _ret;
+  });
+  RT_CHECK(vx_copy_from_dev(warps.data(), buffer, 0, size), {
+    vx_mem_free(buffer);
+    return _ret;
+  });
+  vx_mem_free(buffer);
+
+  // aggregate the records per region and per core
+  std::map<uint32_t, prof_stats_t> regions;
+  std::map<uint32_t, std::vector<prof_stats_t>> region_cores;
+  uint64_t dropped = 0;
+  for (uint32_t core_id = 0; core_id < num_cores; ++core_id) {
+    for (uint32_t wid = 0; wid < num_warps; ++wid) {
+      uint32_t index = core_id * num_warps + wid;
+      if (index >= warps.size())
+        break;
+      auto& warp = warps.at(index);
+      uint32_t count = std::min<uint32_t>(warp.count, PROF_RING_SIZE);
+      dropped += warp.count - count;
+      for (uint32_t i = 0; i < count; ++i) {
+        auto& record = warp.ring[i];
+        regions[record.id].add(record);
+        auto& cores = region_cores[record.id];
+        cores.resize(num_cores);
+        cores.at(core_id).add(record);
+      }
+    }
+  }
+
+  for (auto& region : regions) {
+    auto& stats = region.second;
+    fprintf(stream, "PROF: region=%d, count=%ld, cycles(min=%d, avg=%ld, max=%d), instrs(avg=%ld)\n",
+      region.first, stats.count, stats.min_cycles, stats.cycles / stats.count, stats.max_cycles, stats.instrs / stats.count);
+    auto& cores = region_cores.at(region.first);
+    for (uint32_t core_id = 0; core_id < num_cores; ++core_id) {
+      auto& core_stats = cores.at(core_id);
+      if (core_stats.count == 0)
+        continue;
+      fprintf(stream, "PROF:   core%d: count=%ld, cycles(min=%d, avg=%ld, max=%d), instrs(avg=%ld)\n",
+        core_id, core_stats.count, core_stats.min_cycles, core_stats.cycles / core_stats.count, core_stats.max_cycles, core_stats.instrs / core_stats.count);
+    }
+  }
+  if (dropped != 0) {
+    fprintf(stream, "PROF: warning: %ld records were overwritten, increase PROF_RING_SIZE\n", dropped);
+  }
+  if (warps.size() < num_cores * num_warps) {
+    fprintf(stream, "PROF: warning: only the first %ld warps were profiled, increase PROF_MAX_WARPS\n", warps.size());
+  }
+
+  fflush(stream);
+
+  return 0;
+}
+
 int vx_check_occupancy(vx_device_h hdevice, uint32_t group_size, uint32_t* max_barriers, uint32_t* max_localmem) {
+  API_TRACE(hdevice, 0);
+
    // check group size
   uint64_t warps_per_core, threads_per_warp;
   RT_CHECK(vx_dev_caps(hdevice, VX_CAPS_NUM_WARPS, &warps_per_core), {
@@ -780,4 +1372,60 @@ int vx_check_occupancy(vx_device_h hdevice, uint32_t group_size, uint32_t* max_b
   }
 
   return 0;
+}
+
+int vx_pick_block_dim(vx_device_h hdevice, uint32_t dimension, const uint32_t* global_dim, uint32_t local_mem_per_thread, uint32_t* block_dim) {
+  API_TRACE(hdevice, 0);
+
+  if (dimension < 1 || dimension > 3)
+    return -1;
+
+  uint64_t warps_per_core, threads_per_warp;
+  RT_CHECK(vx_dev_caps(hdevice, VX_CAPS_NUM_WARPS, &warps_per_core), {
+    return _ret;
+  });
+  RT_CHECK(vx_dev_caps(hdevice, VX_CAPS_NUM_THREADS, &threads_per_warp), {
+    return _ret;
+  });
+  uint32_t threads_per_core = warps_per_core * threads_per_warp;
+
+  uint32_t max_size = 1;
+  while ((max_size * 2) <= threads_per_core) {
+    max_size *= 2;
+  }
+
+  for (uint32_t group_size = max_size; group_size != 0; group_size /= 2) {
+    // grow the dimensions in turn, keeping each one a divisor of the grid
+    uint32_t shape[3] = {1, 1, 1};
+    uint32_t remaining = group_size;
+    bool grown = true;
+    while (remaining > 1 && grown) {
+      grown = false;
+      for (uint32_t d = 0; d < dimension && remaining > 1; ++d) {
+        if ((global_dim[d] % (shape[d] * 2)) == 0) {
+          shape[d] *= 2;
+          remaining /= 2;
+          grown = true;
+        }
+      }
+    }
+    if (remaining != 1)
+      continue;
+
+    uint32_t max_barriers, max_localmem;
+    RT_CHECK(vx_check_occupancy(hdevice, group_size, &max_barriers, &max_localmem), {
+      return _ret;
+    });
+    if (max_barriers == 0)
+      continue;
+    if (uint64_t(local_mem_per_thread) * group_size > max_localmem)
+      continue;
+
+    for (uint32_t d = 0; d < dimension; ++d) {
+      block_dim[d] = shape[d];
+    }
+    return 0;
+  }
+
+  return -1;
 }
\ No newline at end of file
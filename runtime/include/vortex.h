@@ -22,8 +22,15 @@
 extern "C" {
 #endif
 
+// Thread safety: device and buffer calls may be issued concurrently from any thread,
+// each device serializes them with its own lock. vx_dev_caps and vx_mem_address do not lock.
+// Mailboxes, argument rings and graphs should be driven by one thread at a time.
+
 typedef void* vx_device_h;
 typedef void* vx_buffer_h;
+typedef void* vx_mailbox_h;
+typedef void* vx_arg_ring_h;
+typedef void* vx_graph_h;
 
 // device caps ids
 #define VX_CAPS_VERSION             0x0
@@ -64,7 +71,13 @@ typedef void* vx_buffer_h;
 #define VX_MEM_WRITE                0x2
 #define VX_MEM_READ_WRITE           0x3
 
-// open the device and connect to it
+// return the number of available devices
+int vx_dev_count(uint32_t* count);
+
+// open the device at the given index and connect to it
+int vx_dev_open_index(uint32_t index, vx_device_h* hdevice);
+
+// open the default device (index 0) and connect to it
 int vx_dev_open(vx_device_h* hdevice);
 
 // Close the device when all the operations are done
@@ -112,6 +125,9 @@ int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value);
 // query device performance counter
 int vx_mpm_query(vx_device_h hdevice, uint32_t addr, uint32_t core_id, uint64_t* value);
 
+// replay a captured graph on its device, use vx_ready_wait for completion
+int vx_graph_launch(vx_graph_h hgraph);
+
 ////////////////////////////// UTILITY FUNCTIONS //////////////////////////////
 
 // upload bytes to device
@@ -126,12 +142,72 @@ int vx_upload_bytes(vx_device_h hdevice, const void* content, uint64_t size, vx_
 // upload file to device
 int vx_upload_file(vx_device_h hdevice, const char* filename, vx_buffer_h* hbuffer);
 
+// mark an uploaded kernel as initialized, later launches will skip its startup code.
+// The first launch's exit already ran the kernel's static destructors and later launches
+// do not construct them again, so warm start is unsafe for kernels with static destructors
+int vx_kernel_warm_start(vx_buffer_h hkernel, int enable);
+
+// allocate a device heap of the given size for the kernel's vx_malloc (see vx_memory.h),
+// the caller releases it with vx_mem_free; a zero size detaches the kernel's heap.
+// This clears the kernel's warm start mark, so the next launch resets the allocator
+int vx_kernel_heap(vx_device_h hdevice, vx_buffer_h hkernel, uint64_t size, vx_buffer_h* hheap);
+
+// create a mailbox ring to stream work descriptors to a persistent kernel (see vx_mailbox.h),
+// the capacity must be a power of two
+int vx_mailbox_create(vx_device_h hdevice, uint32_t capacity, uint32_t desc_size, vx_mailbox_h* hmailbox);
+
+// return the mailbox device address
+int vx_mailbox_address(vx_mailbox_h hmailbox, uint64_t* address);
+
+// append a work descriptor and return its completion ticket
+int vx_mailbox_submit(vx_mailbox_h hmailbox, const void* desc, uint64_t* ticket);
+
+// wait for a submitted work descriptor to complete with milliseconds timeout
+int vx_mailbox_wait(vx_mailbox_h hmailbox, uint64_t ticket, uint64_t timeout);
+
+// terminate the persistent kernel once all submitted work completes
+int vx_mailbox_stop(vx_mailbox_h hmailbox);
+
+// release the mailbox
+int vx_mailbox_destroy(vx_mailbox_h hmailbox);
+
+// create a ring of preallocated kernel argument slots reused across launches (at least 2)
+int vx_arg_ring_create(vx_device_h hdevice, uint32_t num_slots, uint32_t slot_size, vx_arg_ring_h* hring);
+
+// bind the arguments to the next free slot and start the kernel with them (see vx_kernel_args)
+int vx_arg_ring_start(vx_arg_ring_h hring, vx_buffer_h hkernel, const void* args, uint32_t size);
+
+// release the argument ring
+int vx_arg_ring_destroy(vx_arg_ring_h hring);
+
+// create an empty graph to capture a sequence of device operations
+int vx_graph_create(vx_device_h hdevice, vx_graph_h* hgraph);
+
+// capture a host to device copy, the host memory is read at each replay
+int vx_graph_copy_to_dev(vx_graph_h hgraph, vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size);
+
+// capture a device to host copy, the host memory is written at each replay
+int vx_graph_copy_from_dev(vx_graph_h hgraph, void* host_ptr, vx_buffer_h hbuffer, uint64_t src_offset, uint64_t size);
+
+// capture a kernel launch, it completes before the following node executes
+int vx_graph_start(vx_graph_h hgraph, vx_buffer_h hkernel, vx_buffer_h harguments);
+
+// release the graph
+int vx_graph_destroy(vx_graph_h hgraph);
+
 // calculate cooperative threads array occupancy
 int vx_check_occupancy(vx_device_h hdevice, uint32_t group_size, uint32_t* max_barriers, uint32_t* max_localmem);
 
+// pick the largest block shape that evenly divides global_dim (threads per dimension)
+// and keeps every core fully occupied given local_mem_per_thread bytes of local memory
+int vx_pick_block_dim(vx_device_h hdevice, uint32_t dimension, const uint32_t* global_dim, uint32_t local_mem_per_thread, uint32_t* block_dim);
+
 // performance counters
 int vx_dump_perf(vx_device_h hdevice, FILE* stream);
 
+// per-region statistics of the kernel's vx_prof_begin/vx_prof_end markers
+int vx_dump_prof(vx_device_h hdevice, FILE* stream);
+
 #ifdef __cplusplus
 }
 #endif
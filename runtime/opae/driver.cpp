@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 #include <sstream>
+#include <mutex>
 
 #ifdef OPAESIM
 #define DEFAULT_OPAE_DRV_PATHS "libopae-c-sim.so"
@@ -34,39 +35,50 @@
 	opae_drv_funcs->func = (pfn_##func)dlsym(dl_handle, #func); \
 	if (opae_drv_funcs->func == nullptr) { \
         printf("dlsym failed: %s\n", dlerror()); \
-		dlclose(dl_handle); \
+        if (0 == dl_refcount) { \
+		    dlclose(dl_handle); \
+            dl_handle = nullptr; \
+        } \
         return -1; \
 	}
 
 void* dl_handle = nullptr;
 
+// the driver library is shared by all opened devices
+static uint32_t dl_refcount = 0;
+static std::mutex dl_mutex;
+
 int drv_init(opae_drv_api_t* opae_drv_funcs) {
     if (opae_drv_funcs == nullptr)
         return -1;
 
-    const char* api_path_s = getenv("OPAE_DRV_PATHS");
-    if (api_path_s == nullptr || api_path_s[0] == '\0') {
-        api_path_s = DEFAULT_OPAE_DRV_PATHS;
-    }
+    std::lock_guard<std::mutex> lock(dl_mutex);
 
-    std::vector<std::string> api_paths;
-    {
-        std::stringstream ss(api_path_s);
-        while (ss.good()) {
-            std::string path;
-            getline(ss, path, ',');
-            api_paths.push_back(path);
-        }
-    }
-    
-    for (auto& api_path : api_paths) {
-		dl_handle = dlopen(api_path.c_str(), RTLD_LAZY | RTLD_LOCAL);
-		if (dl_handle)
-			break;
-	}
     if (dl_handle == nullptr) {
-        printf("dlopen failed: %s\n", dlerror());
-        return -1;
+        const char* api_path_s = getenv("OPAE_DRV_PATHS");
+        if (api_path_s == nullptr || api_path_s[0] == '\0') {
+            api_path_s = DEFAULT_OPAE_DRV_PATHS;
+        }
+
+        std::vector<std::string> api_paths;
+        {
+            std::stringstream ss(api_path_s);
+            while (ss.good()) {
+                std::string path;
+                getline(ss, path, ',');
+                api_paths.push_back(path);
+            }
+        }
+
+        for (auto& api_path : api_paths) {
+            dl_handle = dlopen(api_path.c_str(), RTLD_LAZY | RTLD_LOCAL);
+            if (dl_handle)
+                break;
+        }
+        if (dl_handle == nullptr) {
+            printf("dlopen failed: %s\n", dlerror());
+            return -1;
+        }
     }
 
 	SET_API (fpgaGetProperties);
@@ -85,9 +97,17 @@ int drv_init(opae_drv_api_t* opae_drv_funcs) {
 	SET_API (fpgaReadMMIO64);
 	SET_API (fpgaErrStr);    
 
+    ++dl_refcount;
+
     return 0;
 }
 
 void drv_close() {
-    dlclose(dl_handle);
+    std::lock_guard<std::mutex> lock(dl_mutex);
+    if (dl_refcount == 0)
+        return;
+    if (--dl_refcount == 0) {
+        dlclose(dl_handle);
+        dl_handle = nullptr;
+    }
 }
@@ -13,6 +13,8 @@
 
 #include <vortex.h>
 #include <utils.h>
+#include <api_trace.h>
+#include <graph.h>
 #include <malloc.h>
 #include "driver.h"
 #include <iostream>
@@ -30,6 +32,8 @@
 #include <algorithm>
 #include <memory>
 #include <list>
+#include <vector>
+#include <mutex>
 
 #include <VX_config.h>
 #include <VX_types.h>
@@ -93,6 +97,65 @@ using namespace vortex;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static void destroy_accelerators(const opae_drv_api_t& api_, std::vector<fpga_token>& tokens) {
+    for (auto& token : tokens) {
+        api_.fpgaDestroyToken(&token);
+    }
+    tokens.clear();
+}
+
+// return the tokens of all Vortex accelerators across the available FPGA contexts
+static int enumerate_accelerators(const opae_drv_api_t& api_, std::vector<fpga_token>* tokens) {
+    fpga_properties filter;
+    fpga_guid guid;
+    uint32_t num_matches;
+
+    // Set up a filter that will search for an accelerator
+    CHECK_FPGA_ERR(api_.fpgaGetProperties(nullptr, &filter), {
+        return -1;
+    });
+
+    CHECK_FPGA_ERR(api_.fpgaPropertiesSetObjectType(filter, FPGA_ACCELERATOR), {
+        api_.fpgaDestroyProperties(&filter);
+        return -1;
+    });
+
+    // Add the desired UUID to the filter
+    std::string s_uuid(AFU_ACCEL_UUID);
+    std::replace(s_uuid.begin(), s_uuid.end(), '_', '-');
+    uuid_parse(s_uuid.c_str(), guid);
+    CHECK_FPGA_ERR(api_.fpgaPropertiesSetGUID(filter, guid), {
+        api_.fpgaDestroyProperties(&filter);
+        return -1;
+    });
+
+    // Count the matches first
+    CHECK_FPGA_ERR(api_.fpgaEnumerate(&filter, 1, nullptr, 0, &num_matches), {
+        api_.fpgaDestroyProperties(&filter);
+        return -1;
+    });
+
+    tokens->resize(num_matches);
+    if (num_matches != 0) {
+        CHECK_FPGA_ERR(api_.fpgaEnumerate(&filter, 1, tokens->data(), num_matches, &num_matches), {
+            tokens->clear();
+            api_.fpgaDestroyProperties(&filter);
+            return -1;
+        });
+        tokens->resize(std::min<size_t>(num_matches, tokens->size()));
+    }
+
+    // Not needed anymore
+    CHECK_FPGA_ERR(api_.fpgaDestroyProperties(&filter), {
+        destroy_accelerators(api_, *tokens);
+        return -1;
+    });
+
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 class vx_device {
 public:
     vx_device(opae_drv_api_t api)
@@ -103,6 +166,7 @@ public:
         , staging_ioaddr_(0)
         , staging_ptr_(nullptr)
         , staging_size_(0)
+        , profiling_id_(-1)
     {}
 
     ~vx_device() {
@@ -117,68 +181,43 @@ public:
         profiling_remove(profiling_id_);
     }
 
-    int init() {
-        fpga_token accel_token;
-        fpga_properties filter;
-        fpga_guid guid;
-        uint32_t num_matches;
-
-        // Set up a filter that will search for an accelerator
-        CHECK_FPGA_ERR(api_.fpgaGetProperties(nullptr, &filter), {
-            return -1;
-        });
-
-        CHECK_FPGA_ERR(api_.fpgaPropertiesSetObjectType(filter, FPGA_ACCELERATOR), {
-            api_.fpgaDestroyProperties(&filter);
-            return -1;
-        });
-
-        // Add the desired UUID to the filter
-        std::string s_uuid(AFU_ACCEL_UUID);
-        std::replace(s_uuid.begin(), s_uuid.end(), '_', '-');
-        uuid_parse(s_uuid.c_str(), guid);
-        CHECK_FPGA_ERR(api_.fpgaPropertiesSetGUID(filter, guid), {
-            api_.fpgaDestroyProperties(&filter);
-            return -1;
-        });
-
-        // Do the search across the available FPGA contexts
-        CHECK_FPGA_ERR(api_.fpgaEnumerate(&filter, 1, &accel_token, 1, &num_matches), {
-            api_.fpgaDestroyProperties(&filter);
-            return -1;
-        });
-
-        // Not needed anymore
-        CHECK_FPGA_ERR(api_.fpgaDestroyProperties(&filter), {
-            api_.fpgaDestroyToken(&accel_token);
-            return -1;
+    int init(uint32_t index) {
+        std::vector<fpga_token> accel_tokens;
+        CHECK_ERR(enumerate_accelerators(api_, &accel_tokens), {
+            return err;
         });
 
-        if (num_matches < 1) {
-            fprintf(stderr, "[VXDRV] Error: accelerator %s not found!\n", AFU_ACCEL_UUID);
-            api_.fpgaDestroyToken(&accel_token);
+        if (index >= accel_tokens.size()) {
+            fprintf(stderr, "[VXDRV] Error: accelerator %s #%d not found!\n", AFU_ACCEL_UUID, index);
+            destroy_accelerators(api_, accel_tokens);
             return -1;
         }
 
         // Open accelerator
-        CHECK_FPGA_ERR(api_.fpgaOpen(accel_token, &fpga_, 0), {
-            api_.fpgaDestroyToken(&accel_token);
-            return -1;
-        });
-
-        // Done with token
-        CHECK_FPGA_ERR(api_.fpgaDestroyToken(&accel_token), {
-            api_.fpgaClose(fpga_);
+        CHECK_FPGA_ERR(api_.fpgaOpen(accel_tokens.at(index), &fpga_, 0), {
+            destroy_accelerators(api_, accel_tokens);
             return -1;
         });
 
         {
             // retrieve FPGA global memory size
-            CHECK_FPGA_ERR(api_.fpgaPropertiesGetLocalMemorySize(filter, &global_mem_size_), {
+            fpga_properties accel_props;
+            CHECK_FPGA_ERR(api_.fpgaGetProperties(accel_tokens.at(index), &accel_props), {
+                destroy_accelerators(api_, accel_tokens);
+                api_.fpgaClose(fpga_);
+                return -1;
+            });
+            CHECK_FPGA_ERR(api_.fpgaPropertiesGetLocalMemorySize(accel_props, &global_mem_size_), {
                 // assume 8GB as default
                 global_mem_size_ = GLOBAL_MEM_SIZE;
             });
+            api_.fpgaDestroyProperties(&accel_props);
+        }
 
+        // Done with tokens
+        destroy_accelerators(api_, accel_tokens);
+
+        {
             // Load ISA CAPS
             CHECK_FPGA_ERR(api_.fpgaReadMMIO64(fpga_, 0, MMIO_ISA_CAPS, &isa_caps_), {
                 api_.fpgaClose(fpga_);
@@ -266,6 +305,8 @@ public:
     }
 
     int mem_alloc(uint64_t size, int flags, uint64_t* dev_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t addr;
         CHECK_ERR(global_mem_.allocate(size, &addr), {
             return err;
@@ -279,6 +320,8 @@ public:
     }
 
     int mem_reserve(uint64_t dev_addr, uint64_t size, int flags) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         CHECK_ERR(global_mem_.reserve(dev_addr, size), {
             return err;
         });
@@ -290,6 +333,8 @@ public:
     }
 
     int mem_free(uint64_t dev_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         return global_mem_.release(dev_addr);
     }
 
@@ -298,6 +343,8 @@ public:
     }
 
     int mem_info(uint64_t* mem_free, uint64_t* mem_used) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         if (mem_free)
             *mem_free = global_mem_.free();
         if (mem_used)
@@ -306,6 +353,8 @@ public:
     }
 
     int upload(uint64_t dev_addr, const void* host_ptr, uint64_t size) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         // check alignment
         if (!is_aligned(dev_addr, CACHE_BLOCK_SIZE))
             return -1;
@@ -349,6 +398,8 @@ public:
     }
 
     int download(void* host_ptr, uint64_t dev_addr, uint64_t size) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         // check alignment
         if (!is_aligned(dev_addr, CACHE_BLOCK_SIZE))
             return -1;
@@ -392,6 +443,8 @@ public:
     }
 
     int start(uint64_t krnl_addr, uint64_t args_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         // set kernel info
         CHECK_ERR(this->dcr_write(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff), {
             return err;
@@ -430,6 +483,8 @@ public:
         uint64_t sleep_time_ms = (sleep_time.tv_sec * 1000) + (sleep_time.tv_nsec / 1000000);
 
         for (;;) {
+            // poll under the device lock, release it while sleeping
+            std::unique_lock<std::recursive_mutex> lock(mutex_);
             uint64_t status;
             CHECK_FPGA_ERR(api_.fpgaReadMMIO64(fpga_, 0, MMIO_STATUS, &status), {
                 return -1;
@@ -471,6 +526,7 @@ public:
                 break;
             }
 
+            lock.unlock();
             nanosleep(&sleep_time, nullptr);
             timeout -= sleep_time_ms;
         };
@@ -481,6 +537,8 @@ public:
     }
 
     int dcr_write(uint32_t addr, uint32_t value) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         // write DCR value
         CHECK_FPGA_ERR(api_.fpgaWriteMMIO64(fpga_, 0, MMIO_CMD_ARG0, addr), {
             return -1;
@@ -496,10 +554,14 @@ public:
     }
 
     int dcr_read(uint32_t addr, uint32_t* value) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         return dcrs_.read(addr, value);
     }
 
     int mpm_query(uint32_t addr, uint32_t core_id, uint64_t* value) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint32_t offset = addr - VX_CSR_MPM_BASE;
         if (offset > 31)
             return -1;
@@ -554,6 +616,7 @@ private:
     uint64_t staging_size_;
     std::unordered_map<uint32_t, std::array<uint64_t, 32>> mpm_cache_;
     int profiling_id_;
+    mutable std::recursive_mutex mutex_;
 };
 
 struct vx_buffer {
@@ -564,7 +627,35 @@ struct vx_buffer {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-extern int vx_dev_open(vx_device_h* hdevice) {
+extern int vx_dev_count(uint32_t* count) {
+    API_TRACE(nullptr, 0);
+
+    if (nullptr == count)
+        return -1;
+
+    opae_drv_api_t api;
+    memset(&api, 0, sizeof(opae_drv_api_t));
+    if (drv_init(&api) !=0) {
+        return -1;
+    }
+
+    std::vector<fpga_token> accel_tokens;
+    CHECK_ERR(enumerate_accelerators(api, &accel_tokens), {
+        drv_close();
+        return err;
+    });
+
+    *count = accel_tokens.size();
+
+    destroy_accelerators(api, accel_tokens);
+    drv_close();
+
+    return 0;
+}
+
+extern int vx_dev_open_index(uint32_t index, vx_device_h* hdevice) {
+    API_TRACE(nullptr, 0);
+
     if (nullptr == hdevice)
         return  -1;
 
@@ -577,22 +668,31 @@ extern int vx_dev_open(vx_device_h* hdevice) {
     // allocate device object
     auto device = new vx_device(api);
     if (nullptr == device) {
+        drv_close();
         return -1;
     }
 
     // initialize device
-    CHECK_ERR(device->init(), {
+    CHECK_ERR(device->init(index), {
+        delete device;
+        drv_close();
         return err;
     });
 
-    DBGPRINT("DEV_OPEN: hdevice=%p\n", (void*)device);
+    DBGPRINT("DEV_OPEN: index=%d, hdevice=%p\n", index, (void*)device);
 
     *hdevice = device;
 
     return 0;
 }
 
+extern int vx_dev_open(vx_device_h* hdevice) {
+    return vx_dev_open_index(0, hdevice);
+}
+
 extern int vx_dev_close(vx_device_h hdevice) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -612,6 +712,8 @@ extern int vx_dev_close(vx_device_h hdevice) {
 }
 
 extern int vx_dev_caps(vx_device_h hdevice, uint32_t caps_id, uint64_t *value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -631,6 +733,8 @@ extern int vx_dev_caps(vx_device_h hdevice, uint32_t caps_id, uint64_t *value) {
 }
 
 extern int vx_mem_alloc(vx_device_h hdevice, uint64_t size, int flags, vx_buffer_h* hbuffer) {
+    API_TRACE(hdevice, size);
+
     if (nullptr == hdevice
     || nullptr == hbuffer
     || 0 == size)
@@ -659,6 +763,8 @@ extern int vx_mem_alloc(vx_device_h hdevice, uint64_t size, int flags, vx_buffer
 }
 
 extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size, int flags, vx_buffer_h* hbuffer) {
+    API_TRACE(hdevice, size);
+
     if (nullptr == hdevice
      || nullptr == hbuffer
      || 0 == size)
@@ -684,6 +790,8 @@ extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size,
 }
 
 extern int vx_mem_free(vx_buffer_h hbuffer) {
+    API_TRACE(hbuffer, 0);
+
     if (nullptr == hbuffer)
         return 0;
 
@@ -702,6 +810,8 @@ extern int vx_mem_free(vx_buffer_h hbuffer) {
 }
 
 extern int vx_mem_access(vx_buffer_h hbuffer, uint64_t offset, uint64_t size, int flags) {
+    API_TRACE(hbuffer, size);
+
    if (nullptr == hbuffer)
         return -1;
 
@@ -717,6 +827,8 @@ extern int vx_mem_access(vx_buffer_h hbuffer, uint64_t offset, uint64_t size, in
 }
 
 extern int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address) {
+    API_TRACE(hbuffer, 0);
+
     if (nullptr == hbuffer)
         return -1;
 
@@ -730,6 +842,8 @@ extern int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address) {
 }
 
 extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_used) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -755,6 +869,8 @@ extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_us
 }
 
 extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer || nullptr == host_ptr)
         return -1;
 
@@ -770,6 +886,8 @@ extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t ds
 }
 
 extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_offset, uint64_t size) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer || nullptr == host_ptr)
         return -1;
 
@@ -785,6 +903,8 @@ extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_of
 }
 
 extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h harguments) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice || nullptr == hkernel || nullptr == harguments)
         return -1;
 
@@ -797,7 +917,24 @@ extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h hargum
     return device->start(kernel->addr, arguments->addr);
 }
 
+extern int vx_graph_launch(vx_graph_h hgraph) {
+    API_TRACE(hgraph, 0);
+
+    if (nullptr == hgraph)
+        return -1;
+
+    auto graph = ((vx_graph*)hgraph);
+    auto device = ((vx_device*)graph->device);
+
+    DBGPRINT("GRAPH_LAUNCH: hgraph=%p, nodes=%ld\n", hgraph, graph->nodes.size());
+
+    // issue the nodes back-to-back inside the driver, the graph has completed on return
+    return graph_execute(device, graph->nodes);
+}
+
 extern int vx_ready_wait(vx_device_h hdevice, uint64_t timeout) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -805,10 +942,17 @@ extern int vx_ready_wait(vx_device_h hdevice, uint64_t timeout) {
 
     auto device = ((vx_device*)hdevice);
 
-    return device->ready_wait(timeout);
+    int err = device->ready_wait(timeout);
+    if (err == 0) {
+        API_TRACE_CYCLES(hdevice);
+    }
+
+    return err;
 }
 
 extern int vx_dcr_read(vx_device_h hdevice, uint32_t addr, uint32_t* value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -828,6 +972,8 @@ extern int vx_dcr_read(vx_device_h hdevice, uint32_t addr, uint32_t* value) {
 }
 
 extern int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -839,6 +985,8 @@ extern int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value) {
 }
 
 extern int vx_mpm_query(vx_device_h hdevice, uint32_t addr, uint32_t core_id, uint64_t* value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -17,12 +17,15 @@
 #include <assert.h>
 #include <iostream>
 #include <future>
+#include <mutex>
 #include <list>
 #include <chrono>
 
 #include <vortex.h>
 #include <malloc.h>
 #include <utils.h>
+#include <api_trace.h>
+#include <graph.h>
 #include <VX_config.h>
 #include <VX_types.h>
 
@@ -60,6 +63,18 @@ public:
         , global_mem_(ALLOC_BASE_ADDR, GLOBAL_MEM_SIZE - ALLOC_BASE_ADDR, RAM_PAGE_SIZE, CACHE_BLOCK_SIZE)
     {
         processor_.attach_ram(&ram_);
+
+        // simulation checkpoints (CHECKPOINT=1 builds): save to VORTEX_CHECKPOINT_SAVE
+        // at VORTEX_CHECKPOINT_CYCLE or on SIGUSR1, resume from VORTEX_CHECKPOINT_LOAD
+        auto checkpoint_save = getenv("VORTEX_CHECKPOINT_SAVE");
+        if (checkpoint_save) {
+            auto checkpoint_cycle = getenv("VORTEX_CHECKPOINT_CYCLE");
+            processor_.checkpoint(checkpoint_save, checkpoint_cycle ? strtoull(checkpoint_cycle, nullptr, 0) : -1ull);
+        }
+        auto checkpoint_load = getenv("VORTEX_CHECKPOINT_LOAD");
+        if (checkpoint_load) {
+            processor_.restore(checkpoint_load);
+        }
     }
 
     ~vx_device() {
@@ -120,6 +135,8 @@ public:
     }
 
     int mem_alloc(uint64_t size, int flags, uint64_t* dev_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t addr;
         CHECK_ERR(global_mem_.allocate(size, &addr), {
             return err;
@@ -133,6 +150,8 @@ public:
     }
 
     int mem_reserve(uint64_t dev_addr, uint64_t size, int flags) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         CHECK_ERR(global_mem_.reserve(dev_addr, size), {
             return err;
         });
@@ -144,20 +163,29 @@ public:
     }
 
     int mem_free(uint64_t dev_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         return global_mem_.release(dev_addr);
     }
 
     int mem_access(uint64_t dev_addr, uint64_t size, int flags) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t asize = aligned_size(size, CACHE_BLOCK_SIZE);
         if (dev_addr + asize > GLOBAL_MEM_SIZE)
             return -1;
 
-        ram_.set_acl(dev_addr, size, flags);
+        {
+            std::lock_guard<Processor> lock(processor_);
+            ram_.set_acl(dev_addr, size, flags);
+        }
 
         return 0;
     }
 
     int mem_info(uint64_t* mem_free, uint64_t* mem_used) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         if (mem_free)
             *mem_free = global_mem_.free();
         if (mem_used)
@@ -166,13 +194,13 @@ public:
     }
 
     int upload(uint64_t dest_addr, const void* src, uint64_t size) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t asize = aligned_size(size, CACHE_BLOCK_SIZE);
         if (dest_addr + asize > GLOBAL_MEM_SIZE)
             return -1;
 
-        ram_.enable_acl(false);
-        ram_.write((const uint8_t*)src, dest_addr, size);
-        ram_.enable_acl(true);
+        this->ram_write(dest_addr, src, size);
 
         /*printf("VXDRV: upload %ld bytes from 0x%lx:", size, uintptr_t((uint8_t*)src));
         for (int i = 0;  i < (asize / CACHE_BLOCK_SIZE); ++i) {
@@ -187,13 +215,13 @@ public:
     }
 
     int download(void* dest, uint64_t src_addr, uint64_t size) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t asize = aligned_size(size, CACHE_BLOCK_SIZE);
         if (src_addr + asize > GLOBAL_MEM_SIZE)
             return -1;
 
-        ram_.enable_acl(false);
-        ram_.read((uint8_t*)dest, src_addr, size);
-        ram_.enable_acl(true);
+        this->ram_read(dest, src_addr, size);
 
         /*printf("VXDRV: download %ld bytes to 0x%lx:", size, uintptr_t((uint8_t*)dest));
         for (int i = 0;  i < (asize / CACHE_BLOCK_SIZE); ++i) {
@@ -209,22 +237,48 @@ public:
 
     int start(uint64_t krnl_addr, uint64_t args_addr) {
         // ensure prior run completed
-        if (future_.valid()) {
-            future_.wait();
-        }
+        auto lock = this->wait_idle();
 
         // set kernel info
-        this->dcr_write(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff);
-        this->dcr_write(VX_DCR_BASE_STARTUP_ADDR1, krnl_addr >> 32);
-        this->dcr_write(VX_DCR_BASE_STARTUP_ARG0, args_addr & 0xffffffff);
-        this->dcr_write(VX_DCR_BASE_STARTUP_ARG1, args_addr >> 32);
+        this->set_kernel_info(krnl_addr, args_addr);
 
         profiling_begin(profiling_id_);
 
         // start new run
         future_ = std::async(std::launch::async, [&]{
             processor_.run();
-        });
+        }).share();
+
+        // clear mpm cache
+        mpm_cache_.clear();
+
+        return 0;
+    }
+
+    int graph_launch(const std::vector<vx_graph_node_t>& nodes) {
+        // ensure prior run completed
+        auto lock = this->wait_idle();
+
+        profiling_begin(profiling_id_);
+
+        // chain all nodes on the simulation thread,
+        // the host is only involved again at ready_wait()
+        future_ = std::async(std::launch::async, [this, nodes]{
+            for (auto& node : nodes) {
+                switch (node.type) {
+                case vx_graph_node_t::COPY_TO_DEV:
+                    this->ram_write(node.dev_addr, node.host_ptr, node.size);
+                    break;
+                case vx_graph_node_t::COPY_FROM_DEV:
+                    this->ram_read(node.host_ptr, node.dev_addr, node.size);
+                    break;
+                case vx_graph_node_t::START:
+                    this->set_kernel_info(node.dev_addr, node.arg_addr);
+                    processor_.run();
+                    break;
+                }
+            }
+        }).share();
 
         // clear mpm cache
         mpm_cache_.clear();
@@ -233,36 +287,44 @@ public:
     }
 
     int ready_wait(uint64_t timeout) {
-        if (!future_.valid())
-            return 0;
+        // wait on a copy of the current run's future without holding the device lock
+        std::shared_future<void> future;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            if (!future_.valid())
+                return 0;
+            future = future_;
+        }
         uint64_t timeout_sec = timeout / 1000;
         std::chrono::seconds wait_time(1);
         for (;;) {
             // wait for 1 sec and check status
-            auto status = future_.wait_for(wait_time);
+            auto status = future.wait_for(wait_time);
             if (status == std::future_status::ready)
                 break;
             if (0 == timeout_sec--)
                 return -1;
         }
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         profiling_end(profiling_id_);
         return 0;
     }
 
     int dcr_write(uint32_t addr, uint32_t value) {
-        if (future_.valid()) {
-            future_.wait(); // ensure prior run completed
-        }
-        processor_.dcr_write(addr, value);
-        dcrs_.write(addr, value);
+        auto lock = this->wait_idle(); // ensure prior run completed
+        this->dcr_update(addr, value);
         return 0;
     }
 
     int dcr_read(uint32_t addr, uint32_t* value) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         return dcrs_.read(addr, value);
     }
 
     int mpm_query(uint32_t addr, uint32_t core_id, uint64_t* value) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint32_t offset = addr - VX_CSR_MPM_BASE;
         if (offset > 31)
             return -1;
@@ -277,12 +339,57 @@ public:
     }
 
 private:
+    // wait for the current run to complete and return holding the device lock.
+    // The lock is released while waiting, a persistent kernel may depend on
+    // other host threads (e.g. vx_mailbox_stop) to complete
+    std::unique_lock<std::recursive_mutex> wait_idle() {
+        std::unique_lock<std::recursive_mutex> lock(mutex_);
+        while (future_.valid()
+            && future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            auto future = future_;
+            lock.unlock();
+            future.wait();
+            lock.lock();
+        }
+        return lock;
+    }
+
+    // callers ensure that no run is in progress
+    void set_kernel_info(uint64_t krnl_addr, uint64_t args_addr) {
+        this->dcr_update(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff);
+        this->dcr_update(VX_DCR_BASE_STARTUP_ADDR1, krnl_addr >> 32);
+        this->dcr_update(VX_DCR_BASE_STARTUP_ARG0, args_addr & 0xffffffff);
+        this->dcr_update(VX_DCR_BASE_STARTUP_ARG1, args_addr >> 32);
+    }
+
+    void dcr_update(uint32_t addr, uint32_t value) {
+        processor_.dcr_write(addr, value);
+        dcrs_.write(addr, value);
+    }
+
+    // raw memory access, serialized with the simulation thread through the processor lock
+    void ram_write(uint64_t dest_addr, const void* src, uint64_t size) {
+        // the simulation thread may be running a kernel
+        std::lock_guard<Processor> lock(processor_);
+        ram_.enable_acl(false);
+        ram_.write((const uint8_t*)src, dest_addr, size);
+        ram_.enable_acl(true);
+    }
+
+    void ram_read(void* dest, uint64_t src_addr, uint64_t size) {
+        // the simulation thread may be running a kernel
+        std::lock_guard<Processor> lock(processor_);
+        ram_.enable_acl(false);
+        ram_.read((uint8_t*)dest, src_addr, size);
+        ram_.enable_acl(true);
+    }
 
     RAM                 ram_;
     Processor           processor_;
     MemoryAllocator     global_mem_;
     DeviceConfig        dcrs_;
-    std::future<void>   future_;
+    std::shared_future<void> future_;
+    mutable std::recursive_mutex mutex_;
     std::unordered_map<uint32_t, std::array<uint64_t, 32>> mpm_cache_;
     int                 profiling_id_;
 };
@@ -295,10 +402,29 @@ struct vx_buffer {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-extern int vx_dev_open(vx_device_h* hdevice) {
+extern int vx_dev_count(uint32_t* count) {
+    API_TRACE(nullptr, 0);
+
+    if (nullptr == count)
+        return -1;
+
+    // the verilated model supports a single instance per process
+    *count = 1;
+
+    return 0;
+}
+
+extern int vx_dev_open_index(uint32_t index, vx_device_h* hdevice) {
+    API_TRACE(nullptr, 0);
+
     if (nullptr == hdevice)
         return  -1;
 
+    if (index != 0) {
+        printf("[VXDRV] Error: invalid device index %d, available devices: 1\n", index);
+        return -1;
+    }
+
     auto device = new vx_device();
     if (device == nullptr)
         return -1;
@@ -315,7 +441,13 @@ extern int vx_dev_open(vx_device_h* hdevice) {
     return 0;
 }
 
+extern int vx_dev_open(vx_device_h* hdevice) {
+    return vx_dev_open_index(0, hdevice);
+}
+
 extern int vx_dev_close(vx_device_h hdevice) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -329,6 +461,8 @@ extern int vx_dev_close(vx_device_h hdevice) {
 }
 
 extern int vx_dev_caps(vx_device_h hdevice, uint32_t caps_id, uint64_t *value) {
+    API_TRACE(hdevice, 0);
+
    if (nullptr == hdevice)
         return -1;
 
@@ -348,6 +482,8 @@ extern int vx_dev_caps(vx_device_h hdevice, uint32_t caps_id, uint64_t *value) {
 }
 
 extern int vx_mem_alloc(vx_device_h hdevice, uint64_t size, int flags, vx_buffer_h* hbuffer) {
+    API_TRACE(hdevice, size);
+
     if (nullptr == hdevice
      || nullptr == hbuffer
      || 0 == size)
@@ -374,6 +510,8 @@ extern int vx_mem_alloc(vx_device_h hdevice, uint64_t size, int flags, vx_buffer
 }
 
 extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size, int flags, vx_buffer_h* hbuffer) {
+    API_TRACE(hdevice, size);
+
     if (nullptr == hdevice
      || nullptr == hbuffer
      || 0 == size)
@@ -399,6 +537,8 @@ extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size,
 }
 
 extern int vx_mem_free(vx_buffer_h hbuffer) {
+    API_TRACE(hbuffer, 0);
+
     if (nullptr == hbuffer)
         return 0;
 
@@ -417,6 +557,8 @@ extern int vx_mem_free(vx_buffer_h hbuffer) {
 }
 
 extern int vx_mem_access(vx_buffer_h hbuffer, uint64_t offset, uint64_t size, int flags) {
+    API_TRACE(hbuffer, size);
+
    if (nullptr == hbuffer)
         return -1;
 
@@ -432,6 +574,8 @@ extern int vx_mem_access(vx_buffer_h hbuffer, uint64_t offset, uint64_t size, in
 }
 
 extern int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address) {
+    API_TRACE(hbuffer, 0);
+
     if (nullptr == hbuffer)
         return -1;
 
@@ -445,6 +589,8 @@ extern int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address) {
 }
 
 extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_used) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -470,6 +616,8 @@ extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_us
 }
 
 extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer || nullptr == host_ptr)
         return -1;
 
@@ -485,6 +633,8 @@ extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t ds
 }
 
 extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_offset, uint64_t size) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer || nullptr == host_ptr)
         return -1;
 
@@ -500,6 +650,8 @@ extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_of
 }
 
 extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h harguments) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice || nullptr == hkernel || nullptr == harguments)
         return -1;
 
@@ -512,7 +664,27 @@ extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h hargum
     return device->start(kernel->addr, arguments->addr);
 }
 
+extern int vx_graph_launch(vx_graph_h hgraph) {
+    API_TRACE(hgraph, 0);
+
+    if (nullptr == hgraph)
+        return -1;
+
+    auto graph = ((vx_graph*)hgraph);
+    auto device = ((vx_device*)graph->device);
+
+    DBGPRINT("GRAPH_LAUNCH: hgraph=%p, nodes=%ld\n", hgraph, graph->nodes.size());
+
+    CHECK_ERR(graph_validate(graph, GLOBAL_MEM_SIZE), {
+        return err;
+    });
+
+    return device->graph_launch(graph->nodes);
+}
+
 extern int vx_ready_wait(vx_device_h hdevice, uint64_t timeout) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -520,10 +692,17 @@ extern int vx_ready_wait(vx_device_h hdevice, uint64_t timeout) {
 
     auto device = ((vx_device*)hdevice);
 
-    return device->ready_wait(timeout);
+    int err = device->ready_wait(timeout);
+    if (err == 0) {
+        API_TRACE_CYCLES(hdevice);
+    }
+
+    return err;
 }
 
 extern int vx_dcr_read(vx_device_h hdevice, uint32_t addr, uint32_t* value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice || NULL == value)
         return -1;
 
@@ -543,6 +722,8 @@ extern int vx_dcr_read(vx_device_h hdevice, uint32_t addr, uint32_t* value) {
 }
 
 extern int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -554,6 +735,8 @@ extern int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value) {
 }
 
 extern int vx_mpm_query(vx_device_h hdevice, uint32_t addr, uint32_t core_id, uint64_t* value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -18,9 +18,13 @@
 #include <iostream>
 #include <future>
 #include <chrono>
+#include <mutex>
+#include <list>
 
 #include <vortex.h>
 #include <utils.h>
+#include <api_trace.h>
+#include <graph.h>
 #include <malloc.h>
 
 #include <VX_config.h>
@@ -34,6 +38,7 @@
 #include <constants.h>
 #include <unordered_map>
 #include <array>
+#include <algorithm>
 
 using namespace vortex;
 
@@ -52,25 +57,99 @@ using namespace vortex;
         _cleanup                                \
     } while (false)
 
+#define DEFAULT_NUM_DEVICES 1
+
+static uint32_t get_env_value(const char* name, uint32_t default_value) {
+    const char* value_s = getenv(name);
+    if (value_s == nullptr)
+        return default_value;
+    return atoi(value_s);
+}
+
+// the architecture shape defaults to the build configuration
+// and can be reduced at runtime without rebuilding the simulator.
+// It cannot grow past the build configuration, the kernel's memory layout
+// (IO regions, per-thread stacks and print buffers) is sized from it
+static int get_arch_shape(uint32_t* num_threads, uint32_t* num_warps, uint32_t* num_cores, uint32_t* num_clusters) {
+    uint32_t _num_threads  = get_env_value("VORTEX_NUM_THREADS", NUM_THREADS);
+    uint32_t _num_warps    = get_env_value("VORTEX_NUM_WARPS", NUM_WARPS);
+    uint32_t _num_cores    = get_env_value("VORTEX_NUM_CORES", NUM_CORES);
+    uint32_t _num_clusters = get_env_value("VORTEX_NUM_CLUSTERS", NUM_CLUSTERS);
+
+    if (_num_threads == 0 || _num_threads > NUM_THREADS) {
+        printf("[VXDRV] Error: invalid number of threads %d, supported range is [1, %d]\n", _num_threads, NUM_THREADS);
+        return -1;
+    }
+    if (_num_warps == 0 || _num_warps > NUM_WARPS) {
+        printf("[VXDRV] Error: invalid number of warps %d, supported range is [1, %d]\n", _num_warps, NUM_WARPS);
+        return -1;
+    }
+    if (_num_cores == 0 || _num_cores > NUM_CORES) {
+        printf("[VXDRV] Error: invalid number of cores %d, supported range is [1, %d]\n", _num_cores, NUM_CORES);
+        return -1;
+    }
+    if (_num_clusters == 0 || _num_clusters > NUM_CLUSTERS) {
+        printf("[VXDRV] Error: invalid number of clusters %d, supported range is [1, %d]\n", _num_clusters, NUM_CLUSTERS);
+        return -1;
+    }
+    uint32_t socket_size = std::min<uint32_t>(SOCKET_SIZE, _num_cores);
+    if (0 != (_num_cores % socket_size)) {
+        printf("[VXDRV] Error: number of cores %d should be a multiple of the socket size %d\n", _num_cores, socket_size);
+        return -1;
+    }
+
+    *num_threads  = _num_threads;
+    *num_warps    = _num_warps;
+    *num_cores    = _num_cores;
+    *num_clusters = _num_clusters;
+
+    return 0;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 class vx_device {
 public:
-    vx_device()
-        : arch_(NUM_THREADS, NUM_WARPS, NUM_CORES)
+    vx_device(const Arch& arch)
+        : arch_(arch)
         , ram_(0, RAM_PAGE_SIZE)
         , processor_(arch_)
         , global_mem_(ALLOC_BASE_ADDR, GLOBAL_MEM_SIZE - ALLOC_BASE_ADDR, RAM_PAGE_SIZE, CACHE_BLOCK_SIZE)
+        , profiling_id_(-1)
     {
         // attach memory module
         processor_.attach_ram(&ram_);
+
+        // keep the cache state across launches (VORTEX_WARM_CACHE=1)
+        processor_.set_warm_cache(get_env_value("VORTEX_WARM_CACHE", 0) != 0);
     }
 
     ~vx_device() {
         if (future_.valid()) {
             future_.wait();
         }
+        if (profiling_id_ >= 0) {
+            profiling_remove(profiling_id_);
+        }
+    }
+
+    const Arch& arch() const {
+        return arch_;
+    }
+
+    // return to the just-constructed state so that a later open can reuse
+    // the simulator objects instead of rebuilding them
+    void recycle() {
+        if (future_.valid()) {
+            future_.wait();
+        }
+        future_ = std::shared_future<void>();
         profiling_remove(profiling_id_);
+        profiling_id_ = -1;
+        ram_.clear();
+        global_mem_.reset();
+        mpm_cache_.clear();
+        processor_.invalidate_caches();
     }
 
     int init() {
@@ -88,16 +167,16 @@ public:
             _value = IMPLEMENTATION_ID;
             break;
         case VX_CAPS_NUM_THREADS:
-            _value = NUM_THREADS;
+            _value = arch_.num_threads();
             break;
         case VX_CAPS_NUM_WARPS:
-            _value = NUM_WARPS;
+            _value = arch_.num_warps();
             break;
         case VX_CAPS_NUM_CORES:
-            _value = NUM_CORES * NUM_CLUSTERS;
+            _value = arch_.num_cores() * arch_.num_clusters();
             break;
         case VX_CAPS_NUM_BARRIERS:
-            _value = NUM_BARRIERS;
+            _value = arch_.num_barriers();
             break;
         case VX_CAPS_CACHE_LINE_SIZE:
             _value = CACHE_BLOCK_SIZE;
@@ -124,6 +203,8 @@ public:
     }
 
     int mem_alloc(uint64_t size, int flags, uint64_t* dev_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t addr;
         CHECK_ERR(global_mem_.allocate(size, &addr), {
             return err;
@@ -137,6 +218,8 @@ public:
     }
 
     int mem_reserve(uint64_t dev_addr, uint64_t size, int flags) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         CHECK_ERR(global_mem_.reserve(dev_addr, size), {
             return err;
         });
@@ -148,19 +231,27 @@ public:
     }
 
     int mem_free(uint64_t dev_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         return global_mem_.release(dev_addr);
     }
 
     int mem_access(uint64_t dev_addr, uint64_t size, int flags) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t asize = aligned_size(size, CACHE_BLOCK_SIZE);
         if (dev_addr + asize > GLOBAL_MEM_SIZE)
             return -1;
 
+        // the acl is checked by a running kernel
+        std::lock_guard<Processor> proc_lock(processor_);
         ram_.set_acl(dev_addr, size, flags);
         return 0;
     }
 
     int mem_info(uint64_t* mem_free, uint64_t* mem_used) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         if (mem_free)
             *mem_free = global_mem_.free();
         if (mem_used)
@@ -169,13 +260,13 @@ public:
     }
 
     int upload(uint64_t dest_addr, const void* src, uint64_t size) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t asize = aligned_size(size, CACHE_BLOCK_SIZE);
         if (dest_addr + asize > GLOBAL_MEM_SIZE)
             return -1;
 
-        ram_.enable_acl(false);
-        ram_.write((const uint8_t*)src, dest_addr, size);
-        ram_.enable_acl(true);
+        this->ram_write(dest_addr, src, size);
 
         /*DBGPRINT("upload %ld bytes to 0x%lx\n", size, dest_addr);
         for (uint64_t i = 0; i < size && i < 1024; i += 4) {
@@ -186,13 +277,13 @@ public:
     }
 
     int download(void* dest, uint64_t src_addr, uint64_t size) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t asize = aligned_size(size, CACHE_BLOCK_SIZE);
         if (src_addr + asize > GLOBAL_MEM_SIZE)
             return -1;
 
-        ram_.enable_acl(false);
-        ram_.read((uint8_t*)dest, src_addr, size);
-        ram_.enable_acl(true);
+        this->ram_read(dest, src_addr, size);
 
         /*DBGPRINT("download %ld bytes from 0x%lx\n", size, src_addr);
         for (uint64_t i = 0; i < size && i < 1024; i += 4) {
@@ -204,22 +295,48 @@ public:
 
     int start(uint64_t krnl_addr, uint64_t args_addr) {
         // ensure prior run completed
-        if (future_.valid()) {
-            future_.wait();
-        }
+        auto lock = this->wait_idle();
 
         // set kernel info
-        this->dcr_write(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff);
-        this->dcr_write(VX_DCR_BASE_STARTUP_ADDR1, krnl_addr >> 32);
-        this->dcr_write(VX_DCR_BASE_STARTUP_ARG0, args_addr & 0xffffffff);
-        this->dcr_write(VX_DCR_BASE_STARTUP_ARG1, args_addr >> 32);
+        this->set_kernel_info(krnl_addr, args_addr);
 
         profiling_begin(profiling_id_);
 
         // start new run
         future_ = std::async(std::launch::async, [&]{
             processor_.run();
-        });
+        }).share();
+
+        // clear mpm cache
+        mpm_cache_.clear();
+
+        return 0;
+    }
+
+    int graph_launch(const std::vector<vx_graph_node_t>& nodes) {
+        // ensure prior run completed
+        auto lock = this->wait_idle();
+
+        profiling_begin(profiling_id_);
+
+        // chain all nodes on the simulation thread,
+        // the host is only involved again at ready_wait()
+        future_ = std::async(std::launch::async, [this, nodes]{
+            for (auto& node : nodes) {
+                switch (node.type) {
+                case vx_graph_node_t::COPY_TO_DEV:
+                    this->ram_write(node.dev_addr, node.host_ptr, node.size);
+                    break;
+                case vx_graph_node_t::COPY_FROM_DEV:
+                    this->ram_read(node.host_ptr, node.dev_addr, node.size);
+                    break;
+                case vx_graph_node_t::START:
+                    this->set_kernel_info(node.dev_addr, node.arg_addr);
+                    processor_.run();
+                    break;
+                }
+            }
+        }).share();
 
         // clear mpm cache
         mpm_cache_.clear();
@@ -228,36 +345,45 @@ public:
     }
 
     int ready_wait(uint64_t timeout) {
-        if (!future_.valid())
-            return 0;
+        // wait on a copy of the current run's future without holding the device lock,
+        // other threads can keep uploading to a running kernel
+        std::shared_future<void> future;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            if (!future_.valid())
+                return 0;
+            future = future_;
+        }
         uint64_t timeout_sec = timeout / 1000;
         std::chrono::seconds wait_time(1);
         for (;;) {
             // wait for 1 sec and check status
-            auto status = future_.wait_for(wait_time);
+            auto status = future.wait_for(wait_time);
             if (status == std::future_status::ready)
                 break;
             if (0 == timeout_sec--)
                 return -1;
         }
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         profiling_end(profiling_id_);
         return 0;
     }
 
     int dcr_write(uint32_t addr, uint32_t value) {
-        if (future_.valid()) {
-            future_.wait(); // ensure prior run completed
-        }
-        processor_.dcr_write(addr, value);
-        dcrs_.write(addr, value);
+        auto lock = this->wait_idle(); // ensure prior run completed
+        this->dcr_update(addr, value);
         return 0;
     }
 
     int dcr_read(uint32_t addr, uint32_t* value) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         return dcrs_.read(addr, value);
     }
 
     int mpm_query(uint32_t addr, uint32_t core_id, uint64_t* value) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint32_t offset = addr - VX_CSR_MPM_BASE;
         if (offset > 31)
             return -1;
@@ -272,12 +398,58 @@ public:
     }
 
 private:
+    // wait for the current run to complete and return holding the device lock.
+    // The lock is released while waiting, a persistent kernel may depend on
+    // other host threads (e.g. vx_mailbox_stop) to complete
+    std::unique_lock<std::recursive_mutex> wait_idle() {
+        std::unique_lock<std::recursive_mutex> lock(mutex_);
+        while (future_.valid()
+            && future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            auto future = future_;
+            lock.unlock();
+            future.wait();
+            lock.lock();
+        }
+        return lock;
+    }
+
+    // callers ensure that no run is in progress
+    void set_kernel_info(uint64_t krnl_addr, uint64_t args_addr) {
+        this->dcr_update(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff);
+        this->dcr_update(VX_DCR_BASE_STARTUP_ADDR1, krnl_addr >> 32);
+        this->dcr_update(VX_DCR_BASE_STARTUP_ARG0, args_addr & 0xffffffff);
+        this->dcr_update(VX_DCR_BASE_STARTUP_ARG1, args_addr >> 32);
+    }
+
+    void dcr_update(uint32_t addr, uint32_t value) {
+        processor_.dcr_write(addr, value);
+        dcrs_.write(addr, value);
+    }
+
+    // raw memory access, callers hold the device lock or run on the simulation thread
+    void ram_write(uint64_t dest_addr, const void* src, uint64_t size) {
+        // the device may be running a persistent kernel
+        std::lock_guard<Processor> lock(processor_);
+        ram_.enable_acl(false);
+        ram_.write((const uint8_t*)src, dest_addr, size);
+        ram_.enable_acl(true);
+    }
+
+    void ram_read(void* dest, uint64_t src_addr, uint64_t size) {
+        // the device may be running a persistent kernel
+        std::lock_guard<Processor> lock(processor_);
+        ram_.enable_acl(false);
+        ram_.read((uint8_t*)dest, src_addr, size);
+        ram_.enable_acl(true);
+    }
+
     Arch                arch_;
     RAM                 ram_;
     Processor           processor_;
     MemoryAllocator     global_mem_;
     DeviceConfig        dcrs_;
-    std::future<void>   future_;
+    std::shared_future<void> future_;
+    mutable std::recursive_mutex mutex_;
     std::unordered_map<uint32_t, std::array<uint64_t, 32>> mpm_cache_;
     int profiling_id_;
 };
@@ -290,27 +462,116 @@ struct vx_buffer {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-extern int vx_dev_open(vx_device_h* hdevice) {
+// Closed devices are parked here and handed back to the next open with the same
+// architecture shape, skipping the simulator construction (VORTEX_DEVICE_REUSE=0 disables it)
+class DevicePool {
+public:
+    DevicePool() {
+        enabled_ = get_env_value("VORTEX_DEVICE_REUSE", 1) != 0;
+    }
+
+    ~DevicePool() {
+        for (auto device : devices_) {
+            delete device;
+        }
+    }
+
+    vx_device* acquire(const Arch& arch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+            auto& dev_arch = (*it)->arch();
+            if (dev_arch.num_threads() == arch.num_threads()
+             && dev_arch.num_warps() == arch.num_warps()
+             && dev_arch.num_cores() == arch.num_cores()
+             && dev_arch.num_clusters() == arch.num_clusters()) {
+                auto device = *it;
+                devices_.erase(it);
+                return device;
+            }
+        }
+        return nullptr;
+    }
+
+    void release(vx_device* device) {
+        if (!enabled_) {
+            delete device;
+            return;
+        }
+        device->recycle();
+        std::lock_guard<std::mutex> lock(mutex_);
+        devices_.push_back(device);
+    }
+
+private:
+    std::list<vx_device*> devices_;
+    std::mutex mutex_;
+    bool enabled_;
+};
+
+static DevicePool gDevicePool;
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern int vx_dev_count(uint32_t* count) {
+    API_TRACE(nullptr, 0);
+
+    if (nullptr == count)
+        return -1;
+
+    // each simulated device runs its own processor instance
+    *count = get_env_value("VORTEX_NUM_DEVICES", DEFAULT_NUM_DEVICES);
+
+    return 0;
+}
+
+extern int vx_dev_open_index(uint32_t index, vx_device_h* hdevice) {
+    API_TRACE(nullptr, 0);
+
     if (nullptr == hdevice)
         return  -1;
 
-    auto device = new vx_device();
-    if (device == nullptr)
+    uint32_t num_devices;
+    CHECK_ERR(vx_dev_count(&num_devices), {
+        return err;
+    });
+    if (index >= num_devices) {
+        printf("[VXDRV] Error: invalid device index %d, available devices: %d\n", index, num_devices);
         return -1;
+    }
+
+    uint32_t num_threads, num_warps, num_cores, num_clusters;
+    CHECK_ERR(get_arch_shape(&num_threads, &num_warps, &num_cores, &num_clusters), {
+        return err;
+    });
+
+    Arch arch(num_threads, num_warps, num_cores, num_clusters);
+
+    auto device = gDevicePool.acquire(arch);
+    if (device == nullptr) {
+        device = new vx_device(arch);
+        if (device == nullptr)
+            return -1;
+    }
 
     CHECK_ERR(device->init(), {
         delete device;
         return err;
     });
 
-    DBGPRINT("DEV_OPEN: hdevice=%p\n", (void*)device);
+    DBGPRINT("DEV_OPEN: index=%d, hdevice=%p, shape=%dx%dx%dx%d\n", index, (void*)device, num_clusters, num_cores, num_warps, num_threads);
 
     *hdevice = device;
 
     return 0;
 }
 
+extern int vx_dev_open(vx_device_h* hdevice) {
+    return vx_dev_open_index(0, hdevice);
+}
+
 extern int vx_dev_close(vx_device_h hdevice) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -318,12 +579,14 @@ extern int vx_dev_close(vx_device_h hdevice) {
 
     auto device = ((vx_device*)hdevice);
 
-    delete device;
+    gDevicePool.release(device);
 
     return 0;
 }
 
 extern int vx_dev_caps(vx_device_h hdevice, uint32_t caps_id, uint64_t *value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -343,6 +606,8 @@ extern int vx_dev_caps(vx_device_h hdevice, uint32_t caps_id, uint64_t *value) {
 }
 
 extern int vx_mem_alloc(vx_device_h hdevice, uint64_t size, int flags, vx_buffer_h* hbuffer) {
+    API_TRACE(hdevice, size);
+
     if (nullptr == hdevice
      || nullptr == hbuffer
      || 0 == size)
@@ -369,6 +634,8 @@ extern int vx_mem_alloc(vx_device_h hdevice, uint64_t size, int flags, vx_buffer
 }
 
 extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size, int flags, vx_buffer_h* hbuffer) {
+    API_TRACE(hdevice, size);
+
     if (nullptr == hdevice
      || nullptr == hbuffer
      || 0 == size)
@@ -394,6 +661,8 @@ extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size,
 }
 
 extern int vx_mem_free(vx_buffer_h hbuffer) {
+    API_TRACE(hbuffer, 0);
+
     if (nullptr == hbuffer)
         return 0;
 
@@ -412,6 +681,8 @@ extern int vx_mem_free(vx_buffer_h hbuffer) {
 }
 
 extern int vx_mem_access(vx_buffer_h hbuffer, uint64_t offset, uint64_t size, int flags) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer)
         return -1;
 
@@ -427,6 +698,8 @@ extern int vx_mem_access(vx_buffer_h hbuffer, uint64_t offset, uint64_t size, in
 }
 
 extern int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address) {
+    API_TRACE(hbuffer, 0);
+
     if (nullptr == hbuffer)
         return -1;
 
@@ -440,6 +713,8 @@ extern int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address) {
 }
 
 extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_used) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -465,6 +740,8 @@ extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_us
 }
 
 extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer || nullptr == host_ptr)
         return -1;
 
@@ -480,6 +757,8 @@ extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t ds
 }
 
 extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_offset, uint64_t size) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer || nullptr == host_ptr)
         return -1;
 
@@ -495,6 +774,8 @@ extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_of
 }
 
 extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h harguments) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice || nullptr == hkernel || nullptr == harguments)
         return -1;
 
@@ -507,7 +788,27 @@ extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h hargum
     return device->start(kernel->addr, arguments->addr);
 }
 
+extern int vx_graph_launch(vx_graph_h hgraph) {
+    API_TRACE(hgraph, 0);
+
+    if (nullptr == hgraph)
+        return -1;
+
+    auto graph = ((vx_graph*)hgraph);
+    auto device = ((vx_device*)graph->device);
+
+    DBGPRINT("GRAPH_LAUNCH: hgraph=%p, nodes=%ld\n", hgraph, graph->nodes.size());
+
+    CHECK_ERR(graph_validate(graph, GLOBAL_MEM_SIZE), {
+        return err;
+    });
+
+    return device->graph_launch(graph->nodes);
+}
+
 extern int vx_ready_wait(vx_device_h hdevice, uint64_t timeout) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -515,10 +816,17 @@ extern int vx_ready_wait(vx_device_h hdevice, uint64_t timeout) {
 
     auto device = ((vx_device*)hdevice);
 
-    return device->ready_wait(timeout);
+    int err = device->ready_wait(timeout);
+    if (err == 0) {
+        API_TRACE_CYCLES(hdevice);
+    }
+
+    return err;
 }
 
 extern int vx_dcr_read(vx_device_h hdevice, uint32_t addr, uint32_t* value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice || NULL == value)
         return -1;
 
@@ -538,6 +846,8 @@ extern int vx_dcr_read(vx_device_h hdevice, uint32_t addr, uint32_t* value) {
 }
 
 extern int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -549,6 +859,8 @@ extern int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value) {
 }
 
 extern int vx_mpm_query(vx_device_h hdevice, uint32_t addr, uint32_t core_id, uint64_t* value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -13,6 +13,14 @@
 
 #include <vortex.h>
 
+extern int vx_dev_count(uint32_t* /*count*/) {
+    return -1;
+}
+
+extern int vx_dev_open_index(uint32_t /*index*/, vx_device_h* /*hdevice*/) {
+    return -1;
+}
+
 extern int vx_dev_open(vx_device_h* /*hdevice*/) {
     return -1;
 }
@@ -61,6 +69,10 @@ extern int vx_start(vx_device_h /*hdevice*/, vx_buffer_h /*hkernel*/, vx_buffer_
     return -1;
 }
 
+extern int vx_graph_launch(vx_graph_h /*hgraph*/) {
+    return -1;
+}
+
 extern int vx_ready_wait(vx_device_h /*hdevice*/, uint64_t /*timeout*/) {
     return -1;
 }
@@ -14,6 +14,8 @@
 #include <vortex.h>
 #include <malloc.h>
 #include <utils.h>
+#include <api_trace.h>
+#include <graph.h>
 #include <VX_config.h>
 #include <VX_types.h>
 #include <stdarg.h>
@@ -23,6 +25,7 @@
 #include <string>
 #include <unordered_map>
 #include <array>
+#include <mutex>
 
 #ifdef SCOPE
 #include "scope.h"
@@ -36,6 +39,7 @@
 #include "experimental/xrt_kernel.h"
 #include "experimental/xrt_xclbin.h"
 #include "experimental/xrt_error.h"
+#include "experimental/xrt_system.h"
 #else
 #include <fpga.h>
 #endif
@@ -293,6 +297,8 @@ public:
     }
 
     int mem_alloc(uint64_t size, int flags, uint64_t* dev_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint64_t asize = aligned_size(size, CACHE_BLOCK_SIZE);
         uint64_t addr;
         CHECK_ERR(global_mem_.allocate(asize, &addr), {
@@ -317,7 +323,9 @@ public:
         return 0;
     }
 
-    int mem_reserve(uint64_t dev_addr, uint64_t size, int flags) {\
+    int mem_reserve(uint64_t dev_addr, uint64_t size, int flags) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         CHECK_ERR(global_mem_.reserve(dev_addr, size), {
             return err;
         });
@@ -340,6 +348,8 @@ public:
     }
 
     int mem_free(uint64_t dev_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         CHECK_ERR(global_mem_.release(dev_addr), {
             return err;
         });
@@ -380,6 +390,8 @@ public:
     }
 
     int mem_info(uint64_t* mem_free, uint64_t* mem_used) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         if (mem_free)
             *mem_free = global_mem_.free();
         if (mem_used)
@@ -388,6 +400,8 @@ public:
     }
 
     int write_register(uint32_t addr, uint32_t value) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     #ifdef CPP_API
         xrtKernel_.write_register(addr, value);
     #else
@@ -401,6 +415,8 @@ public:
     }
 
     int read_register(uint32_t addr, uint32_t* value) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     #ifdef CPP_API
         *value = xrtKernel_.read_register(addr);
     #else
@@ -414,6 +430,8 @@ public:
     }
 
     int upload(uint64_t dev_addr, const void* src, uint64_t size) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         auto host_ptr = (const uint8_t*)src;
 
         // check alignment
@@ -461,6 +479,8 @@ public:
     }
 
     int download(void* dest, uint64_t dev_addr, uint64_t size) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         auto host_ptr = (uint8_t*)dest;
 
         // check alignment
@@ -508,6 +528,8 @@ public:
     }
 
     int start(uint64_t krnl_addr, uint64_t args_addr) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         // set kernel info
         CHECK_ERR(this->dcr_write(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff), {
             return err;
@@ -548,6 +570,7 @@ public:
         // to milliseconds
         uint64_t sleep_time_ms = (sleep_time.tv_sec * 1000) + (sleep_time.tv_nsec / 1000000);
 
+        // each status read takes the device lock, it is released while sleeping
         for (;;) {
             uint32_t status = 0;
             CHECK_ERR(this->read_register(MMIO_CTL_ADDR, &status), {
@@ -569,6 +592,8 @@ public:
     }
 
     int dcr_write(uint32_t addr, uint32_t value) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         CHECK_ERR(this->write_register(MMIO_DCR_ADDR, addr), {
             return err;
         });
@@ -580,10 +605,14 @@ public:
     }
 
     int dcr_read(uint32_t addr, uint32_t* value) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         return dcrs_.read(addr, value);
     }
 
     int mpm_query(uint32_t addr, uint32_t core_id, uint64_t* value) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         uint32_t offset = addr - VX_CSR_MPM_BASE;
         if (offset > 31)
             return -1;
@@ -609,6 +638,7 @@ private:
     DeviceConfig dcrs_;
     std::unordered_map<uint32_t, std::array<uint64_t, 32>> mpm_cache_;
     int profiling_id_;
+    mutable std::recursive_mutex mutex_;
 
 #ifdef BANK_INTERLEAVE
 
@@ -702,16 +732,39 @@ struct vx_buffer {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-extern int vx_dev_open(vx_device_h* hdevice) {
+extern int vx_dev_count(uint32_t* count) {
+    API_TRACE(nullptr, 0);
+
+    if (nullptr == count)
+        return -1;
+
+#ifdef CPP_API
+    *count = xrt::system::enumerate_devices();
+#else
+    // the simulated platform exposes a single device
+    *count = 1;
+#endif
+
+    return 0;
+}
+
+extern int vx_dev_open_index(uint32_t index, vx_device_h* hdevice) {
+    API_TRACE(nullptr, 0);
+
     if (nullptr == hdevice)
         return -1;
 
-    int device_index = DEFAULT_DEVICE_INDEX;
-    const char* device_index_s = getenv("XRT_DEVICE_INDEX");
-    if (device_index_s != nullptr) {
-        device_index = atoi(device_index_s);
+    uint32_t num_devices;
+    CHECK_ERR(vx_dev_count(&num_devices), {
+        return err;
+    });
+    if (index >= num_devices) {
+        printf("[VXDRV] Error: invalid device index %d, available devices: %d\n", index, num_devices);
+        return -1;
     }
 
+    int device_index = index;
+
     const char* xlbin_path_s = getenv("XRT_XCLBIN_PATH");
     if (xlbin_path_s == nullptr) {
         xlbin_path_s = DEFAULT_XCLBIN_PATH;
@@ -874,14 +927,25 @@ extern int vx_dev_open(vx_device_h* hdevice) {
     }
 #endif
 
-    DBGPRINT("DEV_OPEN: hdevice=%p\n", (void*)device);
+    DBGPRINT("DEV_OPEN: index=%d, hdevice=%p\n", device_index, (void*)device);
 
     *hdevice = device;
 
     return 0;
 }
 
+extern int vx_dev_open(vx_device_h* hdevice) {
+    uint32_t device_index = DEFAULT_DEVICE_INDEX;
+    const char* device_index_s = getenv("XRT_DEVICE_INDEX");
+    if (device_index_s != nullptr) {
+        device_index = atoi(device_index_s);
+    }
+    return vx_dev_open_index(device_index, hdevice);
+}
+
 extern int vx_dev_close(vx_device_h hdevice) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -899,6 +963,8 @@ extern int vx_dev_close(vx_device_h hdevice) {
 }
 
 extern int vx_dev_caps(vx_device_h hdevice, uint32_t caps_id, uint64_t *value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -918,6 +984,8 @@ extern int vx_dev_caps(vx_device_h hdevice, uint32_t caps_id, uint64_t *value) {
 }
 
 extern int vx_mem_alloc(vx_device_h hdevice, uint64_t size, int flags, vx_buffer_h* hbuffer) {
+    API_TRACE(hdevice, size);
+
    if (nullptr == hdevice
     || nullptr == hbuffer
     || 0 == size)
@@ -946,6 +1014,8 @@ extern int vx_mem_alloc(vx_device_h hdevice, uint64_t size, int flags, vx_buffer
 }
 
 extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size, int flags, vx_buffer_h* hbuffer) {
+    API_TRACE(hdevice, size);
+
     if (nullptr == hdevice
      || nullptr == hbuffer
      || 0 == size)
@@ -971,6 +1041,8 @@ extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size,
 }
 
 extern int vx_mem_free(vx_buffer_h hbuffer) {
+    API_TRACE(hbuffer, 0);
+
     if (nullptr == hbuffer)
         return 0;
 
@@ -989,6 +1061,8 @@ extern int vx_mem_free(vx_buffer_h hbuffer) {
 }
 
 extern int vx_mem_access(vx_buffer_h hbuffer, uint64_t offset, uint64_t size, int flags) {
+    API_TRACE(hbuffer, size);
+
    if (nullptr == hbuffer)
         return -1;
 
@@ -1004,6 +1078,8 @@ extern int vx_mem_access(vx_buffer_h hbuffer, uint64_t offset, uint64_t size, in
 }
 
 extern int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address) {
+    API_TRACE(hbuffer, 0);
+
     if (nullptr == hbuffer)
         return -1;
 
@@ -1017,6 +1093,8 @@ extern int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address) {
 }
 
 extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_used) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -1042,6 +1120,8 @@ extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_us
 }
 
 extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer || nullptr == host_ptr)
         return -1;
 
@@ -1061,6 +1141,8 @@ extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t ds
 }
 
 extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_offset, uint64_t size) {
+    API_TRACE(hbuffer, size);
+
     if (nullptr == hbuffer || nullptr == host_ptr)
         return -1;
 
@@ -1080,6 +1162,8 @@ extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_of
 }
 
 extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h harguments) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice || nullptr == hkernel || nullptr == harguments)
         return -1;
 
@@ -1094,7 +1178,24 @@ extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h hargum
     return device->start(kernel->addr, arguments->addr);
 }
 
+extern int vx_graph_launch(vx_graph_h hgraph) {
+    API_TRACE(hgraph, 0);
+
+    if (nullptr == hgraph)
+        return -1;
+
+    auto graph = ((vx_graph*)hgraph);
+    auto device = ((vx_device*)graph->device);
+
+    DBGPRINT("GRAPH_LAUNCH: hgraph=%p, nodes=%ld\n", hgraph, graph->nodes.size());
+
+    // issue the nodes back-to-back inside the driver, the graph has completed on return
+    return graph_execute(device, graph->nodes);
+}
+
 extern int vx_ready_wait(vx_device_h hdevice, uint64_t timeout) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -1106,10 +1207,14 @@ extern int vx_ready_wait(vx_device_h hdevice, uint64_t timeout) {
         return err;
     });
 
+    API_TRACE_CYCLES(hdevice);
+
     return  0;
 }
 
 extern int vx_dcr_read(vx_device_h hdevice, uint32_t addr, uint32_t* value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -1129,6 +1234,8 @@ extern int vx_dcr_read(vx_device_h hdevice, uint32_t addr, uint32_t* value) {
 }
 
 extern int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -1140,6 +1247,8 @@ extern int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value) {
 }
 
 extern int vx_mpm_query(vx_device_h hdevice, uint32_t addr, uint32_t core_id, uint64_t* value) {
+    API_TRACE(hdevice, 0);
+
     if (nullptr == hdevice)
         return -1;
 
@@ -15,6 +15,8 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <string.h>
 #include <assert.h>
 #include "util.h"
 
@@ -241,6 +243,10 @@ void ACLManager::set(uint64_t addr, uint64_t size, int flags) {
   }
 }
 
+void ACLManager::clear() {
+  acl_map_.clear();
+}
+
 bool ACLManager::check(uint64_t addr, uint64_t size, int flags) const {
   uint64_t end = addr + size;
 
@@ -287,6 +293,10 @@ void RAM::clear() {
   for (auto& page : pages_) {
     delete[] page.second;
   }
+  pages_.clear();
+  last_page_ = nullptr;
+  last_page_index_ = 0;
+  acl_mngr_.clear();
 }
 
 uint64_t RAM::size() const {
@@ -328,9 +338,15 @@ void RAM::read(void* data, uint64_t addr, uint64_t size) {
   if (check_acl_ && acl_mngr_.check(addr, size, 0x1) == false) {
     throw BadAddress();
   }
+  // copy page by page, so there is one page lookup per page touched
+  uint64_t page_size = uint64_t(1) << page_bits_;
   uint8_t* d = (uint8_t*)data;
-  for (uint64_t i = 0; i < size; i++) {
-    d[i] = *this->get(addr + i);
+  while (size != 0) {
+    uint64_t chunk = std::min(size, page_size - (addr & (page_size - 1)));
+    memcpy(d, this->get(addr), chunk);
+    d += chunk;
+    addr += chunk;
+    size -= chunk;
   }
 }
 
@@ -338,9 +354,14 @@ void RAM::write(const void* data, uint64_t addr, uint64_t size) {
   if (check_acl_ && acl_mngr_.check(addr, size, 0x2) == false) {
     throw BadAddress();
   }
+  uint64_t page_size = uint64_t(1) << page_bits_;
   const uint8_t* d = (const uint8_t*)data;
-  for (uint64_t i = 0; i < size; i++) {
-    *this->get(addr + i) = d[i];
+  while (size != 0) {
+    uint64_t chunk = std::min(size, page_size - (addr & (page_size - 1)));
+    memcpy(this->get(addr), d, chunk);
+    d += chunk;
+    addr += chunk;
+    size -= chunk;
   }
 }
 
@@ -351,6 +372,41 @@ void RAM::set_acl(uint64_t addr, uint64_t size, int flags) {
   acl_mngr_.set(addr, size, flags);
 }
 
+void RAM::save(std::ostream& os) const {
+  uint32_t page_size = 1 << page_bits_;
+  uint64_t num_pages = pages_.size();
+  os.write((const char*)&page_size, sizeof(page_size));
+  os.write((const char*)&num_pages, sizeof(num_pages));
+  for (auto& page : pages_) {
+    os.write((const char*)&page.first, sizeof(page.first));
+    os.write((const char*)page.second, page_size);
+  }
+}
+
+void RAM::restore(std::istream& is) {
+  uint32_t page_size;
+  uint64_t num_pages;
+  is.read((char*)&page_size, sizeof(page_size));
+  is.read((char*)&num_pages, sizeof(num_pages));
+  if (!is || page_size != (1u << page_bits_)) {
+    std::cout << "error: RAM page size mismatch" << std::endl;
+    std::abort();
+  }
+  for (auto& page : pages_) {
+    delete[] page.second;
+  }
+  pages_.clear();
+  last_page_ = nullptr;
+  last_page_index_ = 0;
+  for (uint64_t i = 0; i < num_pages; ++i) {
+    uint64_t page_index;
+    is.read((char*)&page_index, sizeof(page_index));
+    uint8_t* ptr = new uint8_t[page_size];
+    is.read((char*)ptr, page_size);
+    pages_.emplace(page_index, ptr);
+  }
+}
+
 void RAM::loadBinImage(const char* filename, uint64_t destination) {
   std::ifstream ifs(filename);
   if (!ifs) {
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <cstdint>
+#include <iosfwd>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -163,6 +164,8 @@ public:
 
     bool check(uint64_t addr, uint64_t size, int flags) const;
 
+    void clear();
+
 private:
 
   struct acl_entry_t {
@@ -192,6 +195,10 @@ public:
   void loadBinImage(const char* filename, uint64_t destination);
   void loadHexImage(const char* filename);
 
+  // save or restore the allocated pages, access control is left unchanged
+  void save(std::ostream& os) const;
+  void restore(std::istream& is);
+
   uint8_t& operator[](uint64_t address) {
     return *this->get(address);
   }
@@ -180,7 +180,7 @@ protected:
   Pkt  pkt_;
 
   static MemoryPool<SimCallEvent<Pkt>>& allocator() {
-    static MemoryPool<SimCallEvent<Pkt>> instance(64);
+    static thread_local MemoryPool<SimCallEvent<Pkt>> instance(64);
     return instance;
   }
 };
@@ -213,7 +213,7 @@ protected:
   Pkt pkt_;
 
   static MemoryPool<SimPortEvent<Pkt>>& allocator() {
-    static MemoryPool<SimPortEvent<Pkt>> instance(64);
+    static thread_local MemoryPool<SimPortEvent<Pkt>> instance(64);
     return instance;
   }
 };
@@ -293,9 +293,29 @@ private:
 
 class SimPlatform {
 public:
+  SimPlatform() : cycles_(0), warm_reset_(false) {}
+
+  virtual ~SimPlatform() {
+    this->clear();
+  }
+
+  // return the platform active on the calling thread
+  // each simulated device owns its platform and activates it before use,
+  // so that several devices can be simulated concurrently
   static SimPlatform& instance() {
     static SimPlatform s_inst;
-    return s_inst;
+    auto current = current_ref();
+    return current ? *current : s_inst;
+  }
+
+  void activate() {
+    current_ref() = this;
+  }
+
+  void deactivate() {
+    if (current_ref() == this) {
+      current_ref() = nullptr;
+    }
   }
 
   bool initialize() {
@@ -304,7 +324,7 @@ public:
   }
 
   void finalize() {
-    instance().clear();
+    this->clear();
   }
 
   template <typename Impl, typename... Args>
@@ -327,7 +347,9 @@ public:
     events_.emplace_back(evt);
   }
 
-  void reset() {
+  // a warm reset lets stateful models (e.g. caches) keep their contents
+  void reset(bool warm = false) {
+    warm_reset_ = warm;
     events_.clear();
     for (auto& object : objects_) {
       object->do_reset();
@@ -335,6 +357,10 @@ public:
     cycles_ = 0;
   }
 
+  bool warm_reset() const {
+    return warm_reset_;
+  }
+
   void tick() {
     // evaluate events
     auto evt_it = events_.begin();
@@ -362,10 +388,9 @@ public:
 
 private:
 
-  SimPlatform() : cycles_(0) {}
-
-  virtual ~SimPlatform() {
-    this->clear();
+  static SimPlatform*& current_ref() {
+    static thread_local SimPlatform* s_current = nullptr;
+    return s_current;
   }
 
   void clear() {
@@ -383,6 +408,7 @@ private:
   std::list<SimObjectBase::Ptr> objects_;
   std::list<SimEventBase::Ptr> events_;
   uint64_t cycles_;
+  bool warm_reset_;
 
   template <typename U> friend class SimPort;
   friend class SimObjectBase;
@@ -22,6 +22,7 @@
 #endif
 
 #include <iostream>
+#include <atomic>
 #include <fstream>
 #include <iomanip>
 #include <mem.h>
@@ -55,6 +56,9 @@
 #undef MEM_BLOCK_SIZE
 #define MEM_BLOCK_SIZE (PLATFORM_PARAM_LOCAL_MEMORY_DATA_WIDTH / 8)
 
+#define MEM_BLOCK_BYTEEN_ALL \
+  ((MEM_BLOCK_SIZE >= 64) ? ~0ull : ((1ull << (MEM_BLOCK_SIZE % 64)) - 1))
+
 #define CACHE_BLOCK_SIZE  64
 
 #define CCI_LATENCY  8
@@ -86,7 +90,8 @@ double sc_time_stamp() {
   return timestamp;
 }
 
-static bool trace_enabled = false;
+// set from DPI calls, which may run on the model's worker threads
+static std::atomic<bool> trace_enabled(false);
 static uint64_t trace_start_time = TRACE_START_TIME;
 static uint64_t trace_stop_time = TRACE_STOP_TIME;
 
@@ -435,11 +440,7 @@ private:
       if (device_->avs_write[b]) {
         uint64_t byteen = device_->avs_byteenable[b];
         uint8_t* data = (uint8_t*)(device_->avs_writedata[b].data());
-        for (int i = 0; i < MEM_BLOCK_SIZE; i++) {
-          if ((byteen >> i) & 0x1) {
-            (*ram_)[byte_addr + i] = data[i];
-          }
-        }
+        this->ram_write_line(byte_addr, data, byteen);
 
         /*printf("%0ld: [sim] MEM Wr Req: bank=%d, addr=%x, data=", timestamp, b, byte_addr);
         for (int i = 0; i < MEM_BLOCK_SIZE; i++) {
@@ -487,6 +488,21 @@ private:
     }
   }
 
+  // write a memory line into the RAM under its byte enables. Lines are aligned
+  // and never cross a RAM page, so the whole line goes through one page lookup.
+  void ram_write_line(uint64_t addr, const uint8_t* data, uint64_t byteen) {
+    uint8_t* line = &(*ram_)[addr];
+    if (byteen == MEM_BLOCK_BYTEEN_ALL) {
+      memcpy(line, data, MEM_BLOCK_SIZE);
+      return;
+    }
+    while (byteen != 0) {
+      int i = __builtin_ctzll(byteen);
+      line[i] = data[i];
+      byteen &= byteen - 1;
+    }
+  }
+
   typedef struct {
     bool ready;
     std::array<uint8_t, MEM_BLOCK_SIZE> data;
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <cstdlib>
 #include <unistd.h>
 #include <util.h>
 #include <mem.h>
@@ -26,19 +27,31 @@
 using namespace vortex;
 
 static void show_usage() {
-   std::cout << "Usage: [-r: riscv-test] [-h: help] <program>" << std::endl;
+   std::cout << "Usage: [-r: riscv-test] [-s <file>: save checkpoint] [-c <cycle>: checkpoint cycle] [-l <file>: load checkpoint] [-h: help] <program>" << std::endl;
 }
 
 bool riscv_test = false;
 const char* program = nullptr;
+const char* checkpoint_save = nullptr;
+uint64_t checkpoint_cycle = -1ull;
+const char* checkpoint_load = nullptr;
 
 static void parse_args(int argc, char **argv) {
   	int c;
-  	while ((c = getopt(argc, argv, "rh?")) != -1) {
+  	while ((c = getopt(argc, argv, "rs:c:l:h?")) != -1) {
     	switch (c) {
 		case 'r':
 			riscv_test = true;
 			break;
+		case 's':
+			checkpoint_save = optarg;
+			break;
+		case 'c':
+			checkpoint_cycle = std::strtoull(optarg, nullptr, 0);
+			break;
+		case 'l':
+			checkpoint_load = optarg;
+			break;
     	case 'h':
     	case '?':
       		show_usage();
@@ -94,6 +107,14 @@ int main(int argc, char **argv) {
 		}
 	}
 
+	// setup checkpoints, a checkpoint without a cycle is saved on SIGUSR1
+	if (checkpoint_save) {
+		processor.checkpoint(checkpoint_save, checkpoint_cycle);
+	}
+	if (checkpoint_load) {
+		processor.restore(checkpoint_load);
+	}
+
 	// run simulation
 	exitcode = processor.run();
 
@@ -24,13 +24,29 @@
 #endif
 
 #ifdef VCD_OUTPUT
+#ifdef FST_OUTPUT
+#include <verilated_fst_c.h>
+typedef VerilatedFstC VerilatedTraceFile;
+#define TRACE_FILE "trace.fst"
+#else
 #include <verilated_vcd_c.h>
+typedef VerilatedVcdC VerilatedTraceFile;
+#define TRACE_FILE "trace.vcd"
+#endif
+#endif
+
+#ifdef SIM_CHECKPOINT
+#include <verilated_save.h>
+#include <csignal>
 #endif
 
 #include <iostream>
+#include <atomic>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <mem.h>
+#include <util.h>
 
 #include <VX_config.h>
 #include <ostream>
@@ -39,6 +55,8 @@
 #include <vector>
 #include <sstream>
 #include <unordered_map>
+#include <mutex>
+#include <thread>
 
 #define RAMULATOR
 #include <ramulator/src/Gem5Wrapper.h>
@@ -69,6 +87,13 @@
 #define VERILATOR_RESET_VALUE 2
 #endif
 
+// quiet cycles before an idle window can be skipped: the busy reports lag the
+// design by a cycle and a request can sit a cycle or two in the untracked
+// buffers between units (interconnect arbiters, coalescer, local memory)
+#ifndef IDLE_QUIET_CYCLES
+#define IDLE_QUIET_CYCLES 4
+#endif
+
 #if (XLEN == 32)
 typedef uint32_t Word;
 #elif (XLEN == 64)
@@ -77,6 +102,9 @@ typedef uint64_t Word;
 #error unsupported XLEN
 #endif
 
+#define MEM_BLOCK_BYTEEN_ALL \
+  ((MEM_BLOCK_SIZE >= 64) ? ~0ull : ((1ull << (MEM_BLOCK_SIZE % 64)) - 1))
+
 #define VL_WDATA_GETW(lwp, i, n, w) \
   VL_SEL_IWII(0, n * w, 0, 0, lwp, i * w, w)
 
@@ -90,7 +118,8 @@ double sc_time_stamp() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static bool trace_enabled = false;
+// set from DPI calls, which may run on the model's worker threads
+static std::atomic<bool> trace_enabled(false);
 static uint64_t trace_start_time = TRACE_START_TIME;
 static uint64_t trace_stop_time  = TRACE_STOP_TIME;
 
@@ -105,6 +134,50 @@ void sim_trace_enable(bool enable) {
   trace_enabled = enable;
 }
 
+#ifdef SIM_SKIP_IDLE
+uint32_t sim_idle_quiet_cores();
+uint32_t sim_idle_busy_units();
+void sim_idle_reset();
+void sim_idle_skip(uint64_t cycles);
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef SIM_CHECKPOINT
+
+#define CHECKPOINT_MAGIC 0x56584350 // "VXCP"
+
+static volatile std::sig_atomic_t checkpoint_requested = 0;
+
+static void checkpoint_signal_handler(int) {
+  checkpoint_requested = 1;
+}
+
+template <typename T>
+static void checkpoint_write(VerilatedSerialize& os, const T& value) {
+  os.write(&value, sizeof(T));
+}
+
+template <typename T>
+static void checkpoint_read(VerilatedDeserialize& is, T& value) {
+  is.read(&value, sizeof(T));
+}
+
+static void checkpoint_write(VerilatedSerialize& os, const std::string& value) {
+  uint64_t size = value.size();
+  os.write(&size, sizeof(size));
+  os.write(value.data(), size);
+}
+
+static void checkpoint_read(VerilatedDeserialize& is, std::string& value) {
+  uint64_t size;
+  is.read(&size, sizeof(size));
+  value.resize(size);
+  is.read(&value[0], size);
+}
+
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
 class Processor::Impl {
@@ -125,13 +198,26 @@ public:
   #endif
 
   #ifdef VCD_OUTPUT
-    Verilated::traceEverOn(true);
-    trace_ = new VerilatedVcdC();
-    device_->trace(trace_, 99);
-    trace_->open("trace.vcd");
+    this->open_trace();
   #endif
 
     ram_ = nullptr;
+    runs_ = 0;
+    pending_locks_ = 0;
+
+  #ifdef SIM_CHECKPOINT
+    checkpoint_cycle_ = -1ull;
+    restore_run_ = 0;
+  #endif
+
+  #ifdef SIM_SKIP_IDLE
+    // idle-cycle skipping is on by default in SIM_SKIP_IDLE builds,
+    // VORTEX_SKIP_IDLE=0 turns it off to compare against full evaluation
+    auto skip_idle = getenv("VORTEX_SKIP_IDLE");
+    skip_idle_ = (skip_idle == nullptr || atoi(skip_idle) != 0);
+    idle_cycles_ = 0;
+    skipped_cycles_ = 0;
+  #endif
 
     // initialize dram simulator
     ramulator::Config ram_config;
@@ -155,6 +241,12 @@ public:
   ~Impl() {
     this->cout_flush();
 
+  #ifdef SIM_SKIP_IDLE
+    if (skip_idle_) {
+      std::cout << std::dec << "[sim] skipped idle cycles: " << skipped_cycles_ << std::endl;
+    }
+  #endif
+
   #ifdef VCD_OUTPUT
     trace_->close();
     delete trace_;
@@ -182,6 +274,45 @@ public:
     ram_ = ram;
   }
 
+  void checkpoint(const char* path, uint64_t cycle) {
+  #ifdef SIM_CHECKPOINT
+    checkpoint_path_ = path;
+    checkpoint_cycle_ = cycle;
+    std::signal(SIGUSR1, checkpoint_signal_handler);
+  #else
+    __unused (path, cycle);
+    std::cout << "*** error: checkpoints require a CHECKPOINT=1 build" << std::endl;
+    std::abort();
+  #endif
+  }
+
+  void restore(const char* path) {
+  #ifdef SIM_CHECKPOINT
+    // only the header is read here, the state is loaded when its run starts
+    VerilatedRestore is;
+    is.open(path);
+    if (!is.isOpen()) {
+      std::cout << "*** error: cannot open checkpoint " << path << std::endl;
+      std::abort();
+    }
+    uint32_t magic;
+    uint64_t cycle;
+    checkpoint_read(is, magic);
+    if (magic != CHECKPOINT_MAGIC) {
+      std::cout << "*** error: invalid checkpoint " << path << std::endl;
+      std::abort();
+    }
+    checkpoint_read(is, restore_run_);
+    checkpoint_read(is, cycle);
+    is.close();
+    restore_path_ = path;
+  #else
+    __unused (path);
+    std::cout << "*** error: checkpoints require a CHECKPOINT=1 build" << std::endl;
+    std::abort();
+  #endif
+  }
+
   int run() {
     int exitcode = 0;
 
@@ -193,9 +324,17 @@ public:
     running_ = true;
     device_->reset = 0;
 
+    bool restored = false;
+  #ifdef SIM_CHECKPOINT
+    if (!restore_path_.empty() && restore_run_ == runs_) {
+      this->load_checkpoint();
+      restored = true;
+    }
+  #endif
+
     // wait on device to go busy
-    while (!device_->busy) {
-      this->tick();
+    while (!restored && !device_->busy) {
+      this->run_tick();
     }
 
     // wait on device to go idle
@@ -204,7 +343,20 @@ public:
         exitcode = (int)get_last_wb_value(3);
         break;
       }
-      this->tick();
+      this->run_tick();
+    #ifdef SIM_CHECKPOINT
+      if (checkpoint_requested
+       || (checkpoint_cycle_ != -1ull && (timestamp / 2) >= checkpoint_cycle_)) {
+        this->save_checkpoint();
+        checkpoint_requested = 0;
+        checkpoint_cycle_ = -1ull;
+      }
+    #endif
+    #ifdef SIM_SKIP_IDLE
+      if (skip_idle_) {
+        this->skip_idle();
+      }
+    #endif
     }
 
     // reset device
@@ -212,9 +364,22 @@ public:
 
     this->cout_flush();
 
+    ++runs_;
+
     return exitcode;
   }
 
+  // host RAM accesses hold this lock, the simulation thread takes it for each cycle
+  void lock() {
+    ++pending_locks_;
+    mutex_.lock();
+  }
+
+  void unlock() {
+    mutex_.unlock();
+    --pending_locks_;
+  }
+
   void dcr_write(uint32_t addr, uint32_t value) {
     device_->dcr_wr_valid = 1;
     device_->dcr_wr_addr  = addr;
@@ -235,6 +400,7 @@ private:
 
     mem_rd_rsp_active_ = false;
     mem_wr_rsp_active_ = false;
+    mem_req_active_ = false;
 
   #ifdef AXI_BUS
     this->reset_axi_bus();
@@ -252,6 +418,22 @@ private:
       device_->clk = 1;
       this->eval();
     }
+
+  #ifdef SIM_SKIP_IDLE
+    sim_idle_reset();
+    idle_cycles_ = 0;
+  #endif
+  }
+
+  void run_tick() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      this->tick();
+    }
+    // let pending host accesses go through
+    while (pending_locks_ != 0) {
+      std::this_thread::yield();
+    }
   }
 
   void tick() {
@@ -276,6 +458,158 @@ private:
   #endif
     this->eval_dcr_bus(1);
 
+    this->dram_tick();
+
+    if (!dram_queue_.empty()) {
+      if (dram_->send(dram_queue_.front()))
+        dram_queue_.pop();
+    }
+
+  #ifndef NDEBUG
+    fflush(stdout);
+  #endif
+  }
+
+#ifdef SIM_CHECKPOINT
+  // The checkpoint holds the Verilator model, the harness bus state and the
+  // RAM contents. Ramulator's internal state is not saved: on restore, reads
+  // still waiting on DRAM and queued writes are issued again to a fresh DRAM
+  // model, so their latencies can differ from the uninterrupted run.
+  void save_checkpoint() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    VerilatedSave os;
+    os.open(checkpoint_path_.c_str());
+    if (!os.isOpen()) {
+      std::cout << "*** error: cannot create checkpoint " << checkpoint_path_ << std::endl;
+      return;
+    }
+
+    checkpoint_write(os, uint32_t(CHECKPOINT_MAGIC));
+    checkpoint_write(os, runs_);
+    checkpoint_write(os, timestamp);
+
+    os << *device_;
+
+    checkpoint_write(os, mem_rd_rsp_active_);
+    checkpoint_write(os, mem_rd_rsp_ready_);
+    checkpoint_write(os, mem_wr_rsp_active_);
+    checkpoint_write(os, mem_wr_rsp_ready_);
+    checkpoint_write(os, mem_req_active_);
+
+    // pending bus transactions
+    checkpoint_write(os, uint64_t(pending_mem_reqs_.size()));
+    for (auto mem_req : pending_mem_reqs_) {
+      checkpoint_write(os, *mem_req);
+    }
+
+    // DRAM writes not yet accepted by ramulator
+    std::vector<uint64_t> dram_writes;
+    auto dram_queue = dram_queue_;
+    while (!dram_queue.empty()) {
+      auto& dram_req = dram_queue.front();
+      if (dram_req.type == ramulator::Request::Type::WRITE) {
+        dram_writes.push_back(dram_req.addr);
+      }
+      dram_queue.pop();
+    }
+    checkpoint_write(os, uint64_t(dram_writes.size()));
+    for (auto addr : dram_writes) {
+      checkpoint_write(os, addr);
+    }
+
+    // console output buffers
+    checkpoint_write(os, uint64_t(print_bufs_.size()));
+    for (auto& buf : print_bufs_) {
+      checkpoint_write(os, buf.first);
+      checkpoint_write(os, buf.second.str());
+    }
+
+    std::stringstream ram_ss;
+    ram_->save(ram_ss);
+    checkpoint_write(os, ram_ss.str());
+
+    os.close();
+
+    std::cout << std::dec << "[sim] checkpoint saved at cycle " << (timestamp / 2) << ": " << checkpoint_path_ << std::endl;
+  }
+
+  void load_checkpoint() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    VerilatedRestore is;
+    is.open(restore_path_.c_str());
+    if (!is.isOpen()) {
+      std::cout << "*** error: cannot open checkpoint " << restore_path_ << std::endl;
+      std::abort();
+    }
+
+    uint32_t magic;
+    uint32_t run;
+    checkpoint_read(is, magic);
+    checkpoint_read(is, run);
+    checkpoint_read(is, timestamp);
+
+    is >> *device_;
+
+    checkpoint_read(is, mem_rd_rsp_active_);
+    checkpoint_read(is, mem_rd_rsp_ready_);
+    checkpoint_read(is, mem_wr_rsp_active_);
+    checkpoint_read(is, mem_wr_rsp_ready_);
+    checkpoint_read(is, mem_req_active_);
+
+    uint64_t count;
+    checkpoint_read(is, count);
+    for (uint64_t i = 0; i < count; ++i) {
+      auto mem_req = new mem_req_t();
+      checkpoint_read(is, *mem_req);
+      pending_mem_reqs_.emplace_back(mem_req);
+      if (mem_req->ready || mem_req->write)
+        continue;
+      ramulator::Request dram_req(
+        mem_req->addr,
+        ramulator::Request::Type::READ,
+        std::bind([&](ramulator::Request& dram_req, mem_req_t* mem_req) {
+            mem_req->ready = true;
+          }, placeholders::_1, mem_req),
+        0
+      );
+      dram_queue_.push(dram_req);
+    }
+
+    checkpoint_read(is, count);
+    for (uint64_t i = 0; i < count; ++i) {
+      uint64_t addr;
+      checkpoint_read(is, addr);
+      ramulator::Request dram_req(
+        addr,
+        ramulator::Request::Type::WRITE,
+        0
+      );
+      dram_queue_.push(dram_req);
+    }
+
+    checkpoint_read(is, count);
+    for (uint64_t i = 0; i < count; ++i) {
+      int index;
+      std::string str;
+      checkpoint_read(is, index);
+      checkpoint_read(is, str);
+      print_bufs_[index] << str;
+    }
+
+    std::string ram_data;
+    checkpoint_read(is, ram_data);
+    std::istringstream ram_ss(ram_data);
+    ram_->restore(ram_ss);
+
+    is.close();
+
+    restore_path_.clear();
+
+    std::cout << std::dec << "[sim] checkpoint restored at cycle " << (timestamp / 2) << std::endl;
+  }
+#endif
+
+  void dram_tick() {
     if (MEM_CYCLE_RATIO > 0) {
       auto cycle = timestamp / 2;
       if ((cycle % MEM_CYCLE_RATIO) == 0)
@@ -284,29 +618,97 @@ private:
       for (int i = MEM_CYCLE_RATIO; i <= 0; ++i)
         dram_->tick();
     }
+  }
 
-    if (!dram_queue_.empty()) {
-      if (dram_->send(dram_queue_.front()))
-        dram_queue_.pop();
+#ifdef SIM_SKIP_IDLE
+  // Once every core is stalled or done, no unit reports being busy (see
+  // SIM_IDLE_BUSY), the memory bus has been silent for IDLE_QUIET_CYCLES and
+  // the oldest request still waits on DRAM, the design cannot change state
+  // until that response arrives. Advance the DRAM model up to the response
+  // without evaluating the RTL; the stalled cores add the skipped cycles to
+  // their cycle counters on the next clock edge.
+  void skip_idle() {
+    bool quiet = !mem_req_active_
+              && !mem_rd_rsp_active_
+              && !mem_wr_rsp_active_
+              && dram_queue_.empty()
+              && !pending_mem_reqs_.empty()
+              && !pending_mem_reqs_.front()->ready
+              && sim_idle_quiet_cores() == (NUM_CLUSTERS * NUM_CORES)
+              && sim_idle_busy_units() == 0;
+    if (!quiet) {
+      idle_cycles_ = 0;
+      return;
     }
+    if (++idle_cycles_ < IDLE_QUIET_CYCLES)
+      return;
 
-  #ifndef NDEBUG
-    fflush(stdout);
-  #endif
+    uint64_t cycles = 0;
+    while (!pending_mem_reqs_.front()->ready) {
+      timestamp += 2;
+      this->dram_tick();
+      ++cycles;
+    }
+    sim_idle_skip(cycles);
+    skipped_cycles_ += cycles;
+    idle_cycles_ = 0;
   }
+#endif
 
   void eval() {
     device_->eval();
   #ifdef VCD_OUTPUT
     if (sim_trace_enabled()) {
       trace_->dump(timestamp);
-    } else {
-      exit(-1);
     }
   #endif
     ++timestamp;
   }
 
+#ifdef VCD_OUTPUT
+  // The waveform is only dumped while sim_trace_enabled() holds: inside the
+  // VORTEX_TRACE_START/VORTEX_TRACE_STOP cycle window, or between trace
+  // triggers (dpi_trace_start/stop, VORTEX_TRACE_PC/VORTEX_TRACE_PC_STOP).
+  // VORTEX_TRACE_SCOPE restricts the dump to a comma-separated list of
+  // hierarchy scopes, VORTEX_TRACE_DEPTH limits the depth below them.
+  void open_trace() {
+    auto start = getenv("VORTEX_TRACE_START");
+    if (start) {
+      trace_start_time = std::strtoull(start, nullptr, 0) * 2;
+    }
+    auto stop = getenv("VORTEX_TRACE_STOP");
+    if (stop) {
+      trace_stop_time = std::strtoull(stop, nullptr, 0) * 2;
+    }
+    // triggered tracing only, when a trigger is set without a window
+    if ((getenv("VORTEX_TRACE_PC") || getenv("VORTEX_TRACE_PC_STOP")) && !start && !stop) {
+      trace_start_time = -1ull;
+    }
+
+    auto depth_s = getenv("VORTEX_TRACE_DEPTH");
+    int depth = depth_s ? atoi(depth_s) : 0;
+
+    Verilated::traceEverOn(true);
+    trace_ = new VerilatedTraceFile();
+
+    auto scope = getenv("VORTEX_TRACE_SCOPE");
+    if (scope) {
+      std::stringstream ss(scope);
+      std::string hier;
+      while (std::getline(ss, hier, ',')) {
+        if (!hier.empty()) {
+          trace_->dumpvars(depth, hier);
+        }
+      }
+    }
+
+    device_->trace(trace_, 99);
+
+    auto filename = getenv("VORTEX_TRACE_FILE");
+    trace_->open(filename ? filename : TRACE_FILE);
+  }
+#endif
+
 #ifdef AXI_BUS
 
   void reset_axi_bus() {
@@ -391,6 +793,7 @@ private:
     uint32_t req_addr = device_->m_axi_wvalid[0] ? device_->m_axi_awaddr[0] : device_->m_axi_araddr[0];
 
     // process memory requests
+    mem_req_active_ = (device_->m_axi_wvalid[0] || device_->m_axi_arvalid[0]);
     if ((device_->m_axi_wvalid[0] || device_->m_axi_arvalid[0]) && running_) {
       if (device_->m_axi_wvalid[0]) {
         uint64_t byteen = device_->m_axi_wstrb[0];
@@ -419,11 +822,7 @@ private:
             }
             printf("\n");
           */
-          for (int i = 0; i < MEM_BLOCK_SIZE; i++) {
-            if ((byteen >> i) & 0x1) {
-              (*ram_)[base_addr + i] = data[i];
-            }
-          }
+          this->ram_write_line(base_addr, data, byteen);
 
           auto mem_req = new mem_req_t();
           mem_req->tag   = device_->m_axi_awid[0];
@@ -515,6 +914,7 @@ private:
     }
 
     // process memory requests
+    mem_req_active_ = device_->mem_req_valid;
     if (device_->mem_req_valid && running_) {
       uint64_t byte_addr = (device_->mem_req_addr * MEM_BLOCK_SIZE);
       if (device_->mem_req_rw) {
@@ -544,11 +944,7 @@ private:
             }
             printf("\n");
           */
-          for (int i = 0; i < MEM_BLOCK_SIZE; i++) {
-            if ((byteen >> i) & 0x1) {
-              (*ram_)[byte_addr + i] = data[i];
-            }
-          }
+          this->ram_write_line(byte_addr, data, byteen);
 
           // send dram request
           ramulator::Request dram_req(
@@ -588,6 +984,21 @@ private:
 
 #endif
 
+  // write a memory line into the RAM under its byte enables. Lines are aligned
+  // and never cross a RAM page, so the whole line goes through one page lookup.
+  void ram_write_line(uint64_t addr, const uint8_t* data, uint64_t byteen) {
+    uint8_t* line = &(*ram_)[addr];
+    if (byteen == MEM_BLOCK_BYTEEN_ALL) {
+      memcpy(line, data, MEM_BLOCK_SIZE);
+      return;
+    }
+    while (byteen != 0) {
+      int i = __builtin_ctzll(byteen);
+      line[i] = data[i];
+      byteen &= byteen - 1;
+    }
+  }
+
   void  reset_dcr_bus() {
     device_->dcr_wr_valid = 0;
   }
@@ -639,7 +1050,7 @@ private:
   VVortex *device_;
 #endif
 #ifdef VCD_OUTPUT
-  VerilatedVcdC *trace_;
+  VerilatedTraceFile *trace_;
 #endif
 
   std::unordered_map<int, std::stringstream> print_bufs_;
@@ -652,6 +1063,8 @@ private:
   bool mem_wr_rsp_active_;
   bool mem_wr_rsp_ready_;
 
+  bool mem_req_active_;
+
   RAM *ram_;
 
   ramulator::Gem5Wrapper* dram_;
@@ -659,6 +1072,24 @@ private:
   std::queue<ramulator::Request> dram_queue_;
 
   bool running_;
+
+  uint32_t runs_;
+
+  std::mutex mutex_;
+  std::atomic<uint32_t> pending_locks_;
+
+#ifdef SIM_CHECKPOINT
+  std::string checkpoint_path_;
+  uint64_t checkpoint_cycle_;
+  std::string restore_path_;
+  uint32_t restore_run_;
+#endif
+
+#ifdef SIM_SKIP_IDLE
+  bool skip_idle_;
+  uint32_t idle_cycles_;
+  uint64_t skipped_cycles_;
+#endif
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -681,4 +1112,20 @@ int Processor::run() {
 
 void Processor::dcr_write(uint32_t addr, uint32_t value) {
   return impl_->dcr_write(addr, value);
+}
+
+void Processor::lock() {
+  impl_->lock();
+}
+
+void Processor::unlock() {
+  impl_->unlock();
+}
+
+void Processor::checkpoint(const char* path, uint64_t cycle) {
+  impl_->checkpoint(path, cycle);
+}
+
+void Processor::restore(const char* path) {
+  impl_->restore(path);
 }
\ No newline at end of file
@@ -31,6 +31,17 @@ public:
 
   void dcr_write(uint32_t addr, uint32_t value);
 
+  // serialize host RAM accesses with a running simulation
+  void lock();
+  void unlock();
+
+  // save a checkpoint to path once the simulation reaches the given cycle,
+  // or whenever the process receives SIGUSR1
+  void checkpoint(const char* path, uint64_t cycle);
+
+  // resume from a checkpoint instead of reset, in the run it was saved from
+  void restore(const char* path);
+
 private:
 
   class Impl;
@@ -17,6 +17,7 @@
 #include <sstream>
 
 #include <cstdlib>
+#include <algorithm>
 #include <stdio.h>
 #include "types.h"
 
@@ -29,6 +30,7 @@ private:
   uint16_t num_cores_;  
   uint16_t num_clusters_;  
   uint16_t socket_size_;
+  uint16_t num_sockets_;
   uint16_t vsize_;
   uint16_t num_regs_;
   uint16_t num_csrs_;
@@ -36,12 +38,13 @@ private:
   uint16_t ipdom_size_;
   
 public:
-  Arch(uint16_t num_threads, uint16_t num_warps, uint16_t num_cores)   
+  Arch(uint16_t num_threads, uint16_t num_warps, uint16_t num_cores, uint16_t num_clusters = NUM_CLUSTERS)   
     : num_threads_(num_threads)
     , num_warps_(num_warps)
     , num_cores_(num_cores)
-    , num_clusters_(NUM_CLUSTERS)
-    , socket_size_(SOCKET_SIZE)
+    , num_clusters_(num_clusters)
+    , socket_size_(std::min<uint16_t>(SOCKET_SIZE, num_cores))
+    , num_sockets_((num_cores + socket_size_ - 1) / socket_size_)
     , vsize_(16)
     , num_regs_(32)
     , num_csrs_(4096)
@@ -88,6 +91,10 @@ public:
   uint16_t socket_size() const {
     return socket_size_;
   }
+
+  uint16_t num_sockets() const {
+    return num_sockets_;
+  }
 };
 
 }
\ No newline at end of file
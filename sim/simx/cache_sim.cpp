@@ -156,6 +156,7 @@ struct bank_req_t {
 	uint64_t uuid;
 	ReqType  type;
 	bool     write;
+	MemHint  hint;
 
 	bank_req_t(uint32_t num_ports)
 		: ports(num_ports)
@@ -346,8 +347,16 @@ public:
 		if (config_.bypass)
 			return;
 
-		for (auto& bank : banks_) {
-			bank.clear();
+		if (SimPlatform::instance().warm_reset()) {
+			// keep the tags from the previous run, only drop in-flight requests
+			for (auto& bank : banks_) {
+				bank.mshr.clear();
+			}
+		} else {
+			for (auto& bank : banks_) {
+				bank.clear();
+			}
+			init_cycles_ = params_.sets_per_bank * params_.lines_per_set;
 		}
 		perf_stats_ = PerfStats();
 		pending_read_reqs_  = 0;
@@ -423,6 +432,13 @@ public:
 				continue;
 			}
 
+			// forward prefetches that target a lower level
+			if (core_req.hint == MemHint::Prefetch && core_req.level > config_.level) {
+				this->processBypassRequest(core_req, req_id);
+				core_req_port.pop();
+				continue;
+			}
+
 			auto bank_id = params_.addr_bank_id(core_req.addr);
 			auto& bank = banks_.at(bank_id);
 			auto& pipeline_req = pipeline_reqs_.at(bank_id);
@@ -437,15 +453,26 @@ public:
 
 			// check MSHR capacity
 			if ((!core_req.write || !config_.write_through)
+			 && core_req.hint != MemHint::Flush
 		   && bank.mshr.full()) {
+				if (core_req.hint == MemHint::Prefetch) {
+					// drop the prefetch rather than stalling requests behind it
+					DT(3, simobject_->name() << "-drop-" << core_req);
+					core_req_port.pop();
+					continue;
+				}
 				++perf_stats_.mshr_stalls;
 				continue;
 			}
 
+			// prefetches and flushes occupy the pipeline without a response port
+			bool rsp_valid = !core_req.no_response();
+
 			// check bank conflicts
 			if (pipeline_req.type == bank_req_t::Core) {
 				// check port conflict
 				if (pipeline_req.write != core_req.write
+				 || pipeline_req.hint != core_req.hint
 				 || pipeline_req.set_id != set_id
 				 || pipeline_req.tag != tag
 				 || pipeline_req.ports.at(port_id).valid) {
@@ -453,23 +480,24 @@ public:
 					continue;
 				}
 				// extend request ports
-				pipeline_req.ports.at(port_id) = bank_req_port_t{req_id, core_req.tag, true};
+				pipeline_req.ports.at(port_id) = bank_req_port_t{req_id, core_req.tag, rsp_valid};
 			} else {
 				// schedule new request
 				bank_req_t bank_req(config_.ports_per_bank);
-				bank_req.ports.at(port_id) = bank_req_port_t{req_id, core_req.tag, true};
+				bank_req.ports.at(port_id) = bank_req_port_t{req_id, core_req.tag, rsp_valid};
 				bank_req.tag   = tag;
 				bank_req.set_id = set_id;
 				bank_req.cid   = core_req.cid;
 				bank_req.uuid  = core_req.uuid;
 				bank_req.type  = bank_req_t::Core;
 				bank_req.write = core_req.write;
+				bank_req.hint  = core_req.hint;
 				pipeline_req   = bank_req;
 			}
 
 			if (core_req.write)
 				++perf_stats_.writes;
-			else
+			else if (rsp_valid)
 				++perf_stats_.reads;
 
 			// remove request
@@ -513,6 +541,36 @@ private:
 		}
 	}
 
+	void processFlushRequest(uint32_t bank_id, const bank_req_t& pipeline_req) {
+		auto& set = banks_.at(bank_id).sets.at(pipeline_req.set_id);
+		auto addr = params_.mem_addr(bank_id, pipeline_req.set_id, pipeline_req.tag);
+		for (auto& line : set.lines) {
+			if (!line.valid || line.tag != pipeline_req.tag)
+				continue;
+			if (line.dirty) {
+				// write back dirty line
+				MemReq mem_req;
+				mem_req.addr  = addr;
+				mem_req.write = true;
+				mem_req.cid   = pipeline_req.cid;
+				mem_req.uuid  = pipeline_req.uuid;
+				mem_req_ports_.at(bank_id).push(mem_req, 1);
+				DT(3, simobject_->name() << "-dram-" << mem_req);
+				++perf_stats_.evictions;
+			}
+			line.clear();
+		}
+		// invalidate the next level
+		MemReq mem_req;
+		mem_req.addr  = addr;
+		mem_req.write = false;
+		mem_req.cid   = pipeline_req.cid;
+		mem_req.uuid  = pipeline_req.uuid;
+		mem_req.hint  = MemHint::Flush;
+		mem_req_ports_.at(bank_id).push(mem_req, 1);
+		DT(3, simobject_->name() << "-dram-" << mem_req);
+	}
+
 	void processBankRequests() {
 		for (uint32_t bank_id = 0, n = (1 << config_.B); bank_id < n; ++bank_id) {
 			auto& bank = banks_.at(bank_id);
@@ -525,10 +583,12 @@ private:
 				// update cache line
 				auto& bank  = banks_.at(bank_id);
 				auto& entry = bank.mshr.replay(pipeline_req.tag);
-				auto& set   = bank.sets.at(entry.bank_req.set_id);
-				auto& line  = set.lines.at(entry.line_id);
-				line.valid  = true;
-				line.tag    = entry.bank_req.tag;
+				if (entry.bank_req.hint != MemHint::NoAlloc) {
+					auto& set  = bank.sets.at(entry.bank_req.set_id);
+					auto& line = set.lines.at(entry.line_id);
+					line.valid = true;
+					line.tag   = entry.bank_req.tag;
+				}
 				--pending_fill_reqs_;
 			} break;
 			case bank_req_t::Replay: {
@@ -544,6 +604,11 @@ private:
 				}
 			} break;
 			case bank_req_t::Core: {
+				if (pipeline_req.hint == MemHint::Flush) {
+					this->processFlushRequest(bank_id, pipeline_req);
+					break;
+				}
+
 				int32_t hit_line_id  = -1;
 				int32_t free_line_id = -1;
 				int32_t repl_line_id = 0;
@@ -603,10 +668,11 @@ private:
 					// Miss handling
 					if (pipeline_req.write)
 						++perf_stats_.write_misses;
-					else
+					else if (pipeline_req.hint != MemHint::Prefetch)
 						++perf_stats_.read_misses;
 
-					if (free_line_id == -1 && !config_.write_through) {
+					if (free_line_id == -1 && !config_.write_through
+					 && pipeline_req.hint != MemHint::NoAlloc) {
 						// write back dirty line
 						auto& repl_line = set.lines.at(repl_line_id);
 						if (repl_line.dirty) {
@@ -645,6 +711,10 @@ private:
 						// MSHR lookup
 						auto mshr_pending = bank.mshr.lookup(pipeline_req);
 
+						// the line is already being fetched
+						if (mshr_pending && pipeline_req.hint == MemHint::Prefetch)
+							break;
+
 						// allocate MSHR
 						auto mshr_id = bank.mshr.allocate(pipeline_req, (free_line_id != -1) ? free_line_id : repl_line_id);
 
@@ -656,6 +726,8 @@ private:
 							mem_req.tag   = mshr_id;
 							mem_req.cid   = pipeline_req.cid;
 							mem_req.uuid  = pipeline_req.uuid;
+							if (pipeline_req.hint == MemHint::NoAlloc)
+								mem_req.hint = MemHint::NoAlloc;
 							mem_req_ports_.at(bank_id).push(mem_req, 1);
 							DT(3, simobject_->name() << "-dram-" << mem_req);
 							++pending_fill_reqs_;
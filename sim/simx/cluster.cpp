@@ -25,7 +25,7 @@ Cluster::Cluster(const SimContext& ctx,
   , mem_rsp_port(this)
   , cluster_id_(cluster_id)
   , processor_(processor)
-  , sockets_(NUM_SOCKETS)
+  , sockets_(arch.num_sockets())
   , barriers_(arch.num_barriers(), 0)
   , cores_per_socket_(arch.socket_size())
 {
@@ -74,6 +74,7 @@ Cluster::Cluster(const SimContext& ctx,
     false,                  // write response
     L2_MSHR_SIZE,           // mshr size
     2,                      // pipeline latency
+    2,                      // level
   });
 
   l2cache_->MemReqPort.bind(&this->mem_req_port);
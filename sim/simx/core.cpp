@@ -302,6 +302,10 @@ void Core::issue() {
           case SfuType::CSRRW:
           case SfuType::CSRRS:
           case SfuType::CSRRC: ++perf_stats_.scrb_csrs; break;
+          case SfuType::VOTE:
+          case SfuType::SHFL:
+          case SfuType::REDUCE:
+          case SfuType::SCAN: ++perf_stats_.scrb_wctl; break;
           default: assert(false);
           }
         } break;
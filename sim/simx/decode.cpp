@@ -402,6 +402,42 @@ static const char* op_string(const Instr &instr) {
       default:
         std::abort();
       }
+    case 1:
+      switch (func3) {
+      case 0: return "VOTE.ALL";
+      case 1: return "VOTE.ANY";
+      case 2: return "VOTE.UNI";
+      case 3: return "VOTE.BALLOT";
+      default:
+        std::abort();
+      }
+    case 2:
+      switch (func3) {
+      case 0: return "SHFL.IDX";
+      case 1: return "SHFL.UP";
+      case 2: return "SHFL.DOWN";
+      case 3: return "SHFL.XOR";
+      default:
+        std::abort();
+      }
+    case 3:
+    case 4: {
+      static const char* const reduce_ops[] = {"REDUCE.ADD", "REDUCE.MIN", "REDUCE.MAX", "REDUCE.AND", "REDUCE.OR", "REDUCE.XOR"};
+      static const char* const scan_ops[] = {"SCAN.ADD", "SCAN.MIN", "SCAN.MAX", "SCAN.AND", "SCAN.OR", "SCAN.XOR"};
+      if (func3 > 5)
+        std::abort();
+      return (func7 == 3) ? reduce_ops[func3] : scan_ops[func3];
+    }
+    case 5:
+      switch (func3) {
+      case 0: return "PREFETCH.L1";
+      case 1: return "PREFETCH.L2";
+      case 2: return "PREFETCH.L3";
+      case 3: return "LW.NA";
+      case 4: return "FLUSH";
+      default:
+        std::abort();
+      }
     default:
       std::abort();
     }
@@ -527,6 +563,23 @@ std::shared_ptr<Instr> Emulator::decode(uint32_t code) const {
           std::abort();
         }
         break;
+      case 2: // SHFL
+        instr->setDestReg(rd, RegType::Integer);
+        instr->addSrcReg(rs1, RegType::Integer);
+        instr->addSrcReg(rs2, RegType::Integer);
+        break;
+      case 1: // VOTE
+      case 3: // REDUCE
+      case 4: // SCAN
+        instr->setDestReg(rd, RegType::Integer);
+        instr->addSrcReg(rs1, RegType::Integer);
+        break;
+      case 5: // PREFETCH, LW.NA, FLUSH
+        if (func3 == 3) {
+          instr->setDestReg(rd, RegType::Integer);
+        }
+        instr->addSrcReg(rs1, RegType::Integer);
+        break;
       default:
         std::abort();
       }
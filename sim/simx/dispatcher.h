@@ -16,6 +16,7 @@
 #include "instr_trace.h"
 #include <queue>
 #include <vector>
+#include <algorithm>
 
 namespace vortex {
 
@@ -31,9 +32,9 @@ public:
 		, queues_(ISSUE_WIDTH, std::queue<instr_trace_t*>())
 		, buf_size_(buf_size)
 		, block_size_(block_size)
-		, num_lanes_(num_lanes)
+		, num_lanes_(std::min<uint32_t>(num_lanes, arch.num_threads()))
 		, batch_count_(ISSUE_WIDTH / block_size)
-		, pid_count_(arch.num_threads() / num_lanes)
+		, pid_count_((arch.num_threads() + num_lanes_ - 1) / num_lanes_)
 		, batch_idx_(0)
 		, start_p_(block_size, 0)
 	{}
@@ -13,6 +13,7 @@
 
 #include <iostream>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <math.h>
 #include <assert.h>
@@ -103,6 +104,8 @@ void Emulator::clear() {
   csr_mscratch_ = startup_arg;
 
   stalled_warps_.reset();
+  parked_warps_.reset();
+  parked_ready_.reset();
   active_warps_.reset();
 
   // activate first warp and thread
@@ -136,6 +139,31 @@ instr_trace_t* Emulator::step() {
     stalled_warps_.reset(0);
   }
 
+  // wake up parked warps whose watched word has changed or whose sleep has elapsed
+  if (parked_warps_.any()) {
+    for (size_t wid = 0, nw = arch_.num_warps(); wid < nw; ++wid) {
+      if (!parked_warps_.test(wid))
+        continue;
+      auto& warp = warps_.at(wid);
+      if (warp.park_until != 0) {
+        if (SimPlatform::instance().cycles() < warp.park_until)
+          continue;
+        DP(3, "*** Wake up warp #" << wid);
+      } else {
+        uint32_t value;
+        mmu_.read(&value, warp.park_addr, sizeof(uint32_t), 0);
+        if (value == warp.park_value)
+          continue;
+        DP(3, "*** Unpark warp #" << wid << " at addr: 0x" << std::hex << warp.park_addr);
+      }
+      parked_warps_.reset(wid);
+      if (parked_ready_.test(wid)) {
+        parked_ready_.reset(wid);
+        stalled_warps_.reset(wid);
+      }
+    }
+  }
+
   // find next ready warp
   for (size_t wid = 0, nw = arch_.num_warps(); wid < nw; ++wid) {
     bool warp_active = active_warps_.test(wid);
@@ -218,9 +246,16 @@ void Emulator::suspend(uint32_t wid) {
 void Emulator::resume(uint32_t wid) {
   if (wid != 0xffffffff) {
     assert(stalled_warps_.test(wid));
+    if (parked_warps_.test(wid)) {
+      // keep the warp stalled until its watched word changes
+      parked_ready_.set(wid);
+      return;
+    }
     stalled_warps_.reset(wid);
   } else {
     stalled_warps_.reset();
+    parked_warps_.reset();
+    parked_ready_.reset();
   }
 }
 
@@ -234,6 +269,30 @@ bool Emulator::wspawn(uint32_t num_warps, Word nextPC) {
   return false;
 }
 
+void Emulator::park(uint32_t wid, uint64_t addr, uint32_t value) {
+  // spurious wakeups are allowed, the caller polls the word again
+  uint32_t cur_value;
+  mmu_.read(&cur_value, addr, sizeof(uint32_t), 0);
+  if (cur_value != value)
+    return;
+  DP(3, "*** Park warp #" << wid << " at addr: 0x" << std::hex << addr);
+  auto& warp = warps_.at(wid);
+  warp.park_addr = addr;
+  warp.park_value = value;
+  warp.park_until = 0;
+  parked_warps_.set(wid);
+}
+
+void Emulator::sleep(uint32_t wid, uint32_t cycles) {
+  // a zero count only yields the issue slot until the instruction retires
+  if (cycles == 0)
+    return;
+  DP(3, "*** Sleep warp #" << wid << " for " << cycles << " cycles");
+  auto& warp = warps_.at(wid);
+  warp.park_until = SimPlatform::instance().cycles() + cycles;
+  parked_warps_.set(wid);
+}
+
 bool Emulator::barrier(uint32_t bar_id, uint32_t count, uint32_t wid) {
   if (count < 2)
     return true;
@@ -273,7 +332,12 @@ void Emulator::icache_read(void *data, uint64_t addr, uint32_t size) {
 
 void Emulator::dcache_read(void *data, uint64_t addr, uint32_t size) {
   auto type = get_addr_type(addr);
-  if (type == AddrType::Shared) {
+  if (addr >= uint64_t(IO_PRINT_ADDR)
+   && addr < (uint64_t(IO_PRINT_ADDR) + IO_PRINT_SIZE)) {
+    // advertise the bulk print port to the kernel library
+    uint64_t magic = IO_PRINT_MAGIC;
+    memcpy(data, &magic, std::min<uint32_t>(size, sizeof(magic)));
+  } else if (type == AddrType::Shared) {
     core_->local_mem()->read(data, addr, size);
   } else {
     mmu_.read(data, addr, size, 0);
@@ -287,6 +351,9 @@ void Emulator::dcache_write(const void* data, uint64_t addr, uint32_t size) {
   if (addr >= uint64_t(IO_COUT_ADDR)
    && addr < (uint64_t(IO_COUT_ADDR) + IO_COUT_SIZE)) {
      this->writeToStdOut(data, addr, size);
+  } else if (addr >= uint64_t(IO_PRINT_ADDR)
+          && addr < (uint64_t(IO_PRINT_ADDR) + IO_PRINT_SIZE)) {
+     this->drainPrintBuffer(data, size);
   } else {
     if (type == AddrType::Shared) {
       core_->local_mem()->write(data, addr, size);
@@ -316,8 +383,31 @@ void Emulator::writeToStdOut(const void* data, uint64_t addr, uint32_t size) {
   if (size != 1)
     std::abort();
   uint32_t tid = (addr - IO_COUT_ADDR) & (IO_COUT_SIZE-1);
-  auto& ss_buf = print_bufs_[tid];
   char c = *(char*)data;
+  this->putToStdOut(tid, c);
+}
+
+void Emulator::drainPrintBuffer(const void* data, uint32_t size) {
+  // the store value is the address of a print buffer: {size, hart, data[]}
+  uint64_t buf_addr = 0;
+  memcpy(&buf_addr, data, std::min<uint32_t>(size, sizeof(buf_addr)));
+  uint32_t header[2];
+  mmu_.read(header, buf_addr, sizeof(header), 0);
+  uint32_t count = header[0];
+  uint32_t hart = header[1];
+  if (count > (PRINT_BUF_SIZE - sizeof(header))) {
+    std::cerr << "Error: invalid print buffer size " << count << " at 0x" << std::hex << buf_addr << std::dec << std::endl;
+    std::abort();
+  }
+  std::vector<char> chars(count);
+  mmu_.read(chars.data(), buf_addr + sizeof(header), count, 0);
+  for (auto c : chars) {
+    this->putToStdOut(hart, c);
+  }
+}
+
+void Emulator::putToStdOut(uint32_t tid, char c) {
+  auto& ss_buf = print_bufs_[tid];
   ss_buf << c;
   if (c == '\n') {
     std::cout << std::dec << "#" << tid << ": " << ss_buf.str() << std::flush;
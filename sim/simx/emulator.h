@@ -52,6 +52,10 @@ public:
 
   bool wspawn(uint32_t num_warps, Word nextPC);
 
+  void park(uint32_t wid, uint64_t addr, uint32_t value);
+
+  void sleep(uint32_t wid, uint32_t cycles);
+
   int get_exitcode() const;
 
 private:
@@ -76,6 +80,9 @@ private:
     std::stack<ipdom_entry_t>         ipdom_stack;
     Byte                              fcsr;
     UUIDGenerator                     uui_gen;
+    uint64_t                          park_addr;
+    uint32_t                          park_value;
+    uint64_t                          park_until;
   };
 
   struct wspawn_t {
@@ -100,6 +107,10 @@ private:
 
   void writeToStdOut(const void* data, uint64_t addr, uint32_t size);
 
+  void drainPrintBuffer(const void* data, uint32_t size);
+
+  void putToStdOut(uint32_t tid, char c);
+
   void cout_flush();
 
   Word get_csr(uint32_t addr, uint32_t tid, uint32_t wid);
@@ -120,6 +131,8 @@ private:
   std::vector<warp_t> warps_;
   WarpMask    active_warps_;
   WarpMask    stalled_warps_;
+  WarpMask    parked_warps_;
+  WarpMask    parked_ready_;
   std::vector<WarpMask> barriers_;
   std::unordered_map<int, std::stringstream> print_bufs_;
   MemoryUnit  mmu_;
@@ -337,6 +337,16 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
       }
     }
     rd_write = true;
+    if (0 == rdest && 0 == func7 && 3 == func3) {
+      // SLTU x0 hint: park the warp until the watched word changes
+      trace->fetch_stall = true;
+      this->park(wid, rsdata[thread_last][0].u, rsdata[thread_last][1].u);
+    }
+    if (0 == rdest && 0 == func7 && 2 == func3) {
+      // SLT x0 hint: deschedule the warp for a number of cycles
+      trace->fetch_stall = true;
+      this->sleep(wid, rsdata[thread_last][0].u);
+    }
     break;
   }
   case Opcode::I: {
@@ -1417,6 +1427,137 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
         std::abort();
       }
     } break;
+    case 1: {
+      // VOTE
+      trace->fu_type = FUType::SFU;
+      trace->sfu_type = SfuType::VOTE;
+      trace->used_iregs.set(rsrc0);
+      Word ballot = 0;
+      bool all = true, any = false, uni = true;
+      for (uint32_t t = thread_start; t < num_threads; ++t) {
+        if (!warp.tmask.test(t))
+          continue;
+        bool pred = (rsdata[t][0].i != 0);
+        ballot |= Word(pred) << t;
+        all = all && pred;
+        any = any || pred;
+        uni = uni && (rsdata[t][0].i == rsdata[thread_start][0].i);
+      }
+      WordI result;
+      switch (func3) {
+      case 0: result = all; break;
+      case 1: result = any; break;
+      case 2: result = uni; break;
+      case 3: result = ballot; break;
+      default:
+        std::abort();
+      }
+      for (uint32_t t = thread_start; t < num_threads; ++t) {
+        rddata[t].i = result;
+      }
+      rd_write = true;
+    } break;
+    case 2: {
+      // SHFL
+      trace->fu_type = FUType::SFU;
+      trace->sfu_type = SfuType::SHFL;
+      trace->used_iregs.set(rsrc0);
+      trace->used_iregs.set(rsrc1);
+      for (uint32_t t = thread_start; t < num_threads; ++t) {
+        if (!warp.tmask.test(t))
+          continue;
+        auto lane = rsdata[t][1].i;
+        WordI src;
+        switch (func3) {
+        case 0: src = lane; break;     // IDX
+        case 1: src = t - lane; break; // UP
+        case 2: src = t + lane; break; // DOWN
+        case 3: src = t ^ lane; break; // XOR
+        default:
+          std::abort();
+        }
+        // out-of-range or inactive source lanes return the thread's own value
+        if (src >= 0 && src < WordI(num_threads) && warp.tmask.test(src)) {
+          rddata[t].i = rsdata[src][0].i;
+        } else {
+          rddata[t].i = rsdata[t][0].i;
+        }
+      }
+      rd_write = true;
+    } break;
+    case 3:
+    case 4: {
+      // REDUCE, SCAN
+      trace->fu_type = FUType::SFU;
+      trace->sfu_type = (func7 == 3) ? SfuType::REDUCE : SfuType::SCAN;
+      trace->used_iregs.set(rsrc0);
+      auto combine = [&](WordI a, WordI b)->WordI {
+        switch (func3) {
+        case 0: return a + b;
+        case 1: return std::min(a, b);
+        case 2: return std::max(a, b);
+        case 3: return a & b;
+        case 4: return a | b;
+        case 5: return a ^ b;
+        default:
+          std::abort();
+        }
+      };
+      // inclusive prefix over the active lanes, in lane order
+      WordI acc = rsdata[thread_start][0].i;
+      for (uint32_t t = thread_start; t < num_threads; ++t) {
+        if (!warp.tmask.test(t))
+          continue;
+        if (t != thread_start) {
+          acc = combine(acc, rsdata[t][0].i);
+        }
+        rddata[t].i = acc;
+      }
+      if (func7 == 3) {
+        for (uint32_t t = thread_start; t < num_threads; ++t) {
+          rddata[t].i = acc;
+        }
+      }
+      rd_write = true;
+    } break;
+    case 5: {
+      // cache control: PREFETCH.L1/L2/L3, LW.NA, FLUSH
+      // the hints only affect timing, LW.NA behaves as LW
+      trace->fu_type = FUType::LSU;
+      trace->used_iregs.set(rsrc0);
+      std::shared_ptr<LsuTraceData> trace_data;
+      switch (func3) {
+      case 0:
+      case 1:
+      case 2:
+        trace->lsu_type = LsuType::PREFETCH;
+        trace_data = std::make_shared<LsuTraceData>(num_threads, MemHint::Prefetch, func3 + 1);
+        break;
+      case 3:
+        trace->lsu_type = LsuType::LOAD;
+        trace_data = std::make_shared<LsuTraceData>(num_threads, MemHint::NoAlloc);
+        rd_write = true;
+        break;
+      case 4:
+        trace->lsu_type = LsuType::FLUSH;
+        trace_data = std::make_shared<LsuTraceData>(num_threads, MemHint::Flush);
+        break;
+      default:
+        std::abort();
+      }
+      trace->data = trace_data;
+      for (uint32_t t = thread_start; t < num_threads; ++t) {
+        if (!warp.tmask.test(t))
+          continue;
+        uint64_t mem_addr = rsdata[t][0].i;
+        trace_data->mem_addrs.at(t) = {mem_addr, 4};
+        if (func3 == 3) {
+          uint64_t read_data = 0;
+          this->dcache_read(&read_data, mem_addr, 4);
+          rddata[t].i = sext((Word)read_data, 32);
+        }
+      }
+    } break;
     default:
       std::abort();
     }
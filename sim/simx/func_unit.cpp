@@ -162,10 +162,14 @@ void LsuUnit::tick() {
 			continue;
 		}
 
+		// stores and cache hints do not wait for a response
 		bool is_write = (trace->lsu_type == LsuType::STORE);
+		bool no_rsp = is_write
+		           || (trace->lsu_type == LsuType::PREFETCH)
+		           || (trace->lsu_type == LsuType::FLUSH);
 
 		// check pending queue capacity
-		if (!is_write && state.pending_rd_reqs.full()) {
+		if (!no_rsp && state.pending_rd_reqs.full()) {
 			if (!trace->log_once(true)) {
 				DT(4, "*** " << this->name() << "-queue-full: " << *trace);
 			}
@@ -175,19 +179,19 @@ void LsuUnit::tick() {
 		}
 
 		uint32_t tag = 0;
-		if (!is_write) {
+		if (!no_rsp) {
 			tag = state.pending_rd_reqs.allocate({trace, 0});
 		}
 
 		// send memory request
 		auto num_reqs = this->send_requests(trace, block_idx, tag);
 
-		if (!is_write) {
+		if (!no_rsp) {
 			state.pending_rd_reqs.at(tag).count = num_reqs;
 		}
 
 		// do not wait on writes
-		if (is_write) {
+		if (no_rsp) {
 			output.push(trace, 1);
 		}
 
@@ -221,6 +225,18 @@ int LsuUnit::send_requests(instr_trace_t* trace, int block_idx, int tag) {
 		mem_req.tag   = tag;
 		mem_req.cid   = trace->cid;
 		mem_req.uuid  = trace->uuid;
+		mem_req.hint  = trace_data->hint;
+		mem_req.level = trace_data->level;
+
+		if (mem_req.no_response()) {
+			// only cached addresses have something to prefetch or flush
+			if (type != AddrType::Global)
+				continue;
+			dcache_req_port.push(mem_req, 1);
+			DT(3, "mem-req: addr=0x" << std::hex << mem_req.addr << ", lsu_type=" << trace->lsu_type
+				<< ", rid=" << req_idx << ", " << *trace);
+			continue;
+		}
 
 		dcache_req_port.push(mem_req, 1);
 		DT(3, "mem-req: addr=0x" << std::hex << mem_req.addr << ", tag=" << tag
@@ -272,6 +288,16 @@ void SfuUnit::tick() {
 		case SfuType::CSRRC:
 			output.push(trace, 1);
 			break;
+		case SfuType::VOTE:
+		case SfuType::SHFL:
+			// single pass through the lane crossbar
+			output.push(trace, 2);
+			break;
+		case SfuType::REDUCE:
+		case SfuType::SCAN:
+			// log2(threads) combining stages
+			output.push(trace, 2 + log2ceil(core_->arch().num_threads()));
+			break;
 		case SfuType::BAR: {
 			output.push(trace, 1);
 			if (trace->eop) {
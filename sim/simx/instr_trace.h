@@ -33,7 +33,10 @@ public:
 struct LsuTraceData : public ITraceData {
   using Ptr = std::shared_ptr<LsuTraceData>;
   std::vector<mem_addr_size_t> mem_addrs;
-  LsuTraceData(uint32_t num_threads) : mem_addrs(num_threads) {}
+  MemHint hint;
+  uint8_t level;
+  LsuTraceData(uint32_t num_threads, MemHint hint = MemHint::None, uint8_t level = 0)
+    : mem_addrs(num_threads), hint(hint), level(level) {}
 };
 
 struct SFUTraceData : public ITraceData {
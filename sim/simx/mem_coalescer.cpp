@@ -69,8 +69,9 @@ void MemCoalescer::tick() {
 
     auto& seed = ReqIn.at(i).front();
 
-    // ensure we can allocate a response tag      
-    if (!seed.write && pending_rd_reqs_.full()) {
+    // ensure we can allocate a response tag
+    bool need_tag = !seed.write && !seed.no_response();
+    if (need_tag && pending_rd_reqs_.full()) {
       DT(4, "*** " << this->name() << "-queue-full: " << seed);
       last_index_ = i;
       completed = false;
@@ -94,7 +95,7 @@ void MemCoalescer::tick() {
     }
 
     uint32_t tag = 0;
-    if (!seed.write) {
+    if (need_tag) {
       tag = pending_rd_reqs_.allocate(pending_req_t{seed.tag, mask});
     }
 
@@ -14,6 +14,7 @@
 #include "mem_sim.h"
 #include <vector>
 #include <queue>
+#include <mutex>
 #include <stdlib.h>
 
 DISABLE_WARNING_PUSH
@@ -30,6 +31,9 @@ DISABLE_WARNING_POP
 
 using namespace vortex;
 
+// ramulator registers its statistics in a global list shared by all devices
+static std::mutex g_stats_mutex;
+
 class MemSim::Impl {
 private:
 	MemSim* simobject_;
@@ -42,25 +46,36 @@ public:
 	Impl(MemSim* simobject, const Config& config) 
 		: simobject_(simobject)
 		, config_(config)
-	{
-		ramulator::Config ram_config;
-		ram_config.add("standard", "DDR4");
-		ram_config.add("channels", std::to_string(config.channels));
-		ram_config.add("ranks", "1");
-		ram_config.add("speed", "DDR4_2400R");
-		ram_config.add("org", "DDR4_4Gb_x8");
-		ram_config.add("mapping", "defaultmapping");
-		ram_config.set_core_num(config.num_cores);
-		dram_ = new ramulator::Gem5Wrapper(ram_config, MEM_BLOCK_SIZE);
-		Stats::statlist.output("ramulator.ddr4.log");
-	}
+		, dram_(nullptr)
+	{}
 
 	~Impl() {
+		if (dram_ == nullptr)
+			return;
+		std::lock_guard<std::mutex> lock(g_stats_mutex);
 		dram_->finish();
 		Stats::statlist.printall();
 		delete dram_;
 	}
 
+	// the DRAM model is built on first use, devices that never run a kernel skip its setup
+	ramulator::Gem5Wrapper* dram() {
+		if (dram_ == nullptr) {
+			ramulator::Config ram_config;
+			ram_config.add("standard", "DDR4");
+			ram_config.add("channels", std::to_string(config_.channels));
+			ram_config.add("ranks", "1");
+			ram_config.add("speed", "DDR4_2400R");
+			ram_config.add("org", "DDR4_4Gb_x8");
+			ram_config.add("mapping", "defaultmapping");
+			ram_config.set_core_num(config_.num_cores);
+			std::lock_guard<std::mutex> lock(g_stats_mutex);
+			dram_ = new ramulator::Gem5Wrapper(ram_config, MEM_BLOCK_SIZE);
+			Stats::statlist.output("ramulator.ddr4.log");
+		}
+		return dram_;
+	}
+
 	const PerfStats& perf_stats() const {
 		return perf_stats_;
 	}
@@ -78,13 +93,14 @@ public:
 	}
 
 	void tick() {
+		auto dram = this->dram();
 		if (MEM_CYCLE_RATIO > 0) {
 			auto cycle = SimPlatform::instance().cycles();
 			if ((cycle % MEM_CYCLE_RATIO) == 0)
-				dram_->tick();
+				dram->tick();
 		} else {
 			for (int i = MEM_CYCLE_RATIO; i <= 0; ++i)
-				dram_->tick();
+				dram->tick();
 		}
 					
 		if (simobject_->MemReqPort.empty())
@@ -92,6 +108,13 @@ public:
 		
 		auto& mem_req = simobject_->MemReqPort.front();
 
+		// cache hints that reach memory have nothing left to do
+		if (mem_req.no_response()) {
+			DT(3, simobject_->name() << "-" << mem_req);
+			simobject_->MemReqPort.pop();
+			return;
+		}
+
 		ramulator::Request dram_req( 
 			mem_req.addr,
 			mem_req.write ? ramulator::Request::Type::WRITE : ramulator::Request::Type::READ,
@@ -99,7 +122,7 @@ public:
 			mem_req.cid
 		);
 
-		if (!dram_->send(dram_req))
+		if (!dram->send(dram_req))
 			return;
 		
 		if (mem_req.write) {
@@ -13,14 +13,20 @@
 
 #include "processor.h"
 #include "processor_impl.h"
+#include <thread>
 
 using namespace vortex;
 
 ProcessorImpl::ProcessorImpl(const Arch& arch)
   : arch_(arch)
   , clusters_(arch.num_clusters())
+  , pending_locks_(0)
+  , warm_cache_(false)
+  , caches_valid_(false)
 {
-  SimPlatform::instance().initialize();
+  // simulation objects below are registered with this device's platform
+  platform_.activate();
+  platform_.initialize();
 
   // create memory simulator
   memsim_ = MemSim::Create("dram", MemSim::Config{
@@ -43,6 +49,7 @@ ProcessorImpl::ProcessorImpl(const Arch& arch)
     false,                    // write response
     L3_MSHR_SIZE,             // mshr size
     2,                        // pipeline latency
+    3,                        // level
     }
   );
 
@@ -74,7 +81,8 @@ ProcessorImpl::ProcessorImpl(const Arch& arch)
 }
 
 ProcessorImpl::~ProcessorImpl() {
-  SimPlatform::instance().finalize();
+  platform_.finalize();
+  platform_.deactivate();
 }
 
 void ProcessorImpl::attach_ram(RAM* ram) {
@@ -84,13 +92,23 @@ void ProcessorImpl::attach_ram(RAM* ram) {
 }
 
 int ProcessorImpl::run() {
-  SimPlatform::instance().reset();
+  // bind the calling thread to this device's platform
+  platform_.activate();
+  platform_.reset(warm_cache_ && caches_valid_);
   this->reset();
+  caches_valid_ = true;
 
   bool done;
   int exitcode = 0;
   do {
-    SimPlatform::instance().tick();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      platform_.tick();
+    }
+    // let pending host accesses go through
+    while (pending_locks_ != 0) {
+      std::this_thread::yield();
+    }
     done = true;
     for (auto cluster : clusters_) {
       if (cluster->running()) {
@@ -116,6 +134,25 @@ void ProcessorImpl::dcr_write(uint32_t addr, uint32_t value) {
   dcrs_.write(addr, value);
 }
 
+void ProcessorImpl::lock() {
+  ++pending_locks_;
+  mutex_.lock();
+}
+
+void ProcessorImpl::unlock() {
+  mutex_.unlock();
+  --pending_locks_;
+}
+
+void ProcessorImpl::set_warm_cache(bool enable) {
+  warm_cache_ = enable;
+}
+
+void ProcessorImpl::invalidate_caches() {
+  // the next run starts from a cold reset
+  caches_valid_ = false;
+}
+
 ProcessorImpl::PerfStats ProcessorImpl::perf_stats() const {
   ProcessorImpl::PerfStats perf;
   perf.mem_reads   = perf_mem_reads_;
@@ -145,4 +182,20 @@ int Processor::run() {
 
 void Processor::dcr_write(uint32_t addr, uint32_t value) {
   return impl_->dcr_write(addr, value);
-}
\ No newline at end of file
+}
+
+void Processor::lock() {
+  impl_->lock();
+}
+
+void Processor::unlock() {
+  impl_->unlock();
+}
+
+void Processor::set_warm_cache(bool enable) {
+  impl_->set_warm_cache(enable);
+}
+
+void Processor::invalidate_caches() {
+  impl_->invalidate_caches();
+}
@@ -32,6 +32,16 @@ public:
 
   void dcr_write(uint32_t addr, uint32_t value);
 
+  // serialize host memory accesses with a running simulation
+  void lock();
+  void unlock();
+
+  // keep cache and DRAM state across consecutive runs
+  void set_warm_cache(bool enable);
+
+  // drop the cache state kept by warm mode before the next run
+  void invalidate_caches();
+
 private:
   ProcessorImpl* impl_;
 };
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <atomic>
+
 #include "mem_sim.h"
 #include "cache_sim.h"
 #include "constants.h"
@@ -39,12 +42,21 @@ public:
 
   void dcr_write(uint32_t addr, uint32_t value);
 
+  void lock();
+
+  void unlock();
+
+  void set_warm_cache(bool enable);
+
+  void invalidate_caches();
+
   PerfStats perf_stats() const;
 
 private:
 
   void reset();
 
+  SimPlatform platform_;
   const Arch& arch_;
   std::vector<std::shared_ptr<Cluster>> clusters_;
   DCRS dcrs_;
@@ -54,6 +66,10 @@ private:
   uint64_t perf_mem_writes_;
   uint64_t perf_mem_latency_;
   uint64_t perf_mem_pending_reads_;
+  std::mutex mutex_;
+  std::atomic<uint32_t> pending_locks_;
+  bool warm_cache_;
+  bool caches_valid_;
 };
 
 }
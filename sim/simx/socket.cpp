@@ -48,6 +48,7 @@ Socket::Socket(const SimContext& ctx,
     false,                  // write response
     (uint8_t)arch.num_warps(), // mshr size
     2,                      // pipeline latency
+    1,                      // level
   });
 
   icaches_->MemReqPort.bind(&icache_mem_req_port);
@@ -68,6 +69,7 @@ Socket::Socket(const SimContext& ctx,
     false,                  // write response
     DCACHE_MSHR_SIZE,       // mshr size
     2,                      // pipeline latency
+    1,                      // level
   });
 
   dcaches_->MemReqPort.bind(&dcache_mem_req_port);
@@ -120,7 +120,9 @@ inline std::ostream &operator<<(std::ostream &os, const AluType& type) {
 enum class LsuType {
   LOAD,
   STORE,
-  FENCE
+  FENCE,
+  PREFETCH,
+  FLUSH
 };
 
 inline std::ostream &operator<<(std::ostream &os, const LsuType& type) {
@@ -128,6 +130,8 @@ inline std::ostream &operator<<(std::ostream &os, const LsuType& type) {
   case LsuType::LOAD:  os << "LOAD"; break;
   case LsuType::STORE: os << "STORE"; break;
   case LsuType::FENCE: os << "FENCE"; break;
+  case LsuType::PREFETCH: os << "PREFETCH"; break;
+  case LsuType::FLUSH: os << "FLUSH"; break;
   default: assert(false);
   }
   return os;
@@ -203,7 +207,11 @@ enum class SfuType {
   PRED,
   CSRRW,
   CSRRS,
-  CSRRC
+  CSRRC,
+  VOTE,
+  SHFL,
+  REDUCE,
+  SCAN
 };
 
 inline std::ostream &operator<<(std::ostream &os, const SfuType& type) {
@@ -217,6 +225,10 @@ inline std::ostream &operator<<(std::ostream &os, const SfuType& type) {
   case SfuType::CSRRW:  os << "CSRRW"; break;
   case SfuType::CSRRS:  os << "CSRRS"; break;
   case SfuType::CSRRC:  os << "CSRRC"; break;
+  case SfuType::VOTE:   os << "VOTE"; break;
+  case SfuType::SHFL:   os << "SHFL"; break;
+  case SfuType::REDUCE: os << "REDUCE"; break;
+  case SfuType::SCAN:   os << "SCAN"; break;
   default: assert(false);
   }
   return os;
@@ -240,6 +252,26 @@ inline std::ostream &operator<<(std::ostream &os, const ArbiterType& type) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+enum class MemHint {
+  None,     // regular access
+  NoAlloc,  // read that does not allocate a cache line on a miss
+  Prefetch, // fill the line into cache level 'level' and below, no response
+  Flush     // write back and invalidate the line at every level, no response
+};
+
+inline std::ostream &operator<<(std::ostream &os, const MemHint& hint) {
+  switch (hint) {
+  case MemHint::None:     os << "none"; break;
+  case MemHint::NoAlloc:  os << "noalloc"; break;
+  case MemHint::Prefetch: os << "prefetch"; break;
+  case MemHint::Flush:    os << "flush"; break;
+  default: assert(false);
+  }
+  return os;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 struct MemReq {
   uint64_t addr;
   bool     write;
@@ -247,25 +279,41 @@ struct MemReq {
   uint32_t tag;
   uint32_t cid;
   uint64_t uuid;
+  MemHint  hint;
+  uint8_t  level;
 
   MemReq(uint64_t _addr = 0,
           bool _write = false,
           AddrType _type = AddrType::Global,
           uint64_t _tag = 0,
           uint32_t _cid = 0,
-          uint64_t _uuid = 0
+          uint64_t _uuid = 0,
+          MemHint _hint = MemHint::None,
+          uint8_t _level = 0
   ) : addr(_addr)
     , write(_write)
     , type(_type)
     , tag(_tag)
     , cid(_cid)
     , uuid(_uuid)
+    , hint(_hint)
+    , level(_level)
   {}
+
+  // prefetches and flushes never get a response
+  bool no_response() const {
+    return (hint == MemHint::Prefetch || hint == MemHint::Flush);
+  }
 };
 
 inline std::ostream &operator<<(std::ostream &os, const MemReq& req) {
   os << "mem-" << (req.write ? "wr" : "rd") << ": ";
   os << "addr=0x" << std::hex << req.addr << ", type=" << req.type;
+  if (req.hint != MemHint::None) {
+    os << ", hint=" << req.hint;
+    if (req.hint == MemHint::Prefetch)
+      os << std::dec << ", level=" << int(req.level);
+  }
   os << std::dec << ", tag=" << req.tag << ", cid=" << req.cid;
   os << " (#" << std::dec << req.uuid << ")";
   return os;
@@ -387,8 +435,6 @@ public:
     , num_reqs_(num_inputs / num_outputs)
   {
     assert(delay != 0);
-    assert(num_inputs <= 32);
-    assert(num_outputs <= 32);
     assert(num_inputs >= num_outputs);
 
     // bypass mode
@@ -479,8 +525,6 @@ public:
     , lg_num_reqs_(log2ceil(num_inputs / num_outputs))
   {
     assert(delay != 0);
-    assert(num_inputs <= 32);
-    assert(num_outputs <= 32);
     assert(num_inputs >= num_outputs);
 
     // bypass mode
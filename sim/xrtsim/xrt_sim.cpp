@@ -22,6 +22,7 @@
 #endif
 
 #include <iostream>
+#include <atomic>
 #include <fstream>
 #include <iomanip>
 #include <mem.h>
@@ -79,7 +80,8 @@ double sc_time_stamp() {
   return timestamp;
 }
 
-static bool trace_enabled = false;
+// set from DPI calls, which may run on the model's worker threads
+static std::atomic<bool> trace_enabled(false);
 static uint64_t trace_start_time = TRACE_START_TIME;
 static uint64_t trace_stop_time = TRACE_STOP_TIME;
 
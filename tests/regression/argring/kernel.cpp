@@ -0,0 +1,17 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include "common.h"
+
+void kernel_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<TYPE*>(arg->src_addr);
+	auto dst_ptr = reinterpret_cast<TYPE*>(arg->dst_addr);
+
+	dst_ptr[task_id] += arg->scale * src_ptr[task_id];
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)vx_kernel_args();
+	vx_spawn_tasks(arg->num_points, (vx_spawn_tasks_cb)kernel_body, arg);
+	return 0;
+}
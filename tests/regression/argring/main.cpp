@@ -0,0 +1,188 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include <vortex.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t size = 64;
+uint32_t num_launches = 16;
+uint32_t num_slots = 2;
+
+vx_device_h device = nullptr;
+vx_buffer_h src_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_arg_ring_h arg_ring = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n words] [-r launches] [-s slots] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:r:s:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      size = atoi(optarg);
+      break;
+    case 'r':
+      num_launches = atoi(optarg);
+      break;
+    case 's':
+      num_slots = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(src_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_arg_ring_destroy(arg_ring);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint32_t num_points = size;
+  uint32_t buf_size = num_points * sizeof(TYPE);
+
+  std::cout << "number of points: " << num_points << std::endl;
+  std::cout << "buffer size: " << buf_size << " bytes" << std::endl;
+
+  kernel_arg.num_points = num_points;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &src_buffer));
+  RT_CHECK(vx_mem_address(src_buffer, &kernel_arg.src_addr));
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  std::cout << "dev_src=0x" << std::hex << kernel_arg.src_addr << std::endl;
+  std::cout << "dev_dst=0x" << std::hex << kernel_arg.dst_addr << std::endl;
+
+  // allocate host buffers
+  std::vector<TYPE> h_src(num_points);
+  std::vector<TYPE> h_dst(num_points);
+  for (uint32_t i = 0; i < num_points; ++i) {
+    h_src[i] = std::rand() % 16;
+  }
+
+  // upload source buffer
+  std::cout << "upload source buffer" << std::endl;
+  RT_CHECK(vx_copy_to_dev(src_buffer, h_src.data(), 0, buf_size));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  // create argument ring
+  std::cout << "create argument ring with " << std::dec << num_slots << " slots" << std::endl;
+  RT_CHECK(vx_arg_ring_create(device, num_slots, sizeof(kernel_arg_t), &arg_ring));
+
+  // run the iterative kernel with a new scale per launch, return the elapsed host time
+  auto run_launches = [&](bool use_ring, int* errors)->double {
+    // clear destination buffer
+    std::fill(h_dst.begin(), h_dst.end(), TYPE(0));
+    RT_CHECK(vx_copy_to_dev(dst_buffer, h_dst.data(), 0, buf_size));
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (uint32_t r = 0; r < num_launches; ++r) {
+      kernel_arg.scale = r + 1;
+      if (use_ring) {
+        RT_CHECK(vx_arg_ring_start(arg_ring, krnl_buffer, &kernel_arg, sizeof(kernel_arg_t)));
+      } else {
+        vx_buffer_h args_buffer;
+        RT_CHECK(vx_upload_bytes(device, &kernel_arg, sizeof(kernel_arg_t), &args_buffer));
+        RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+        RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+        RT_CHECK(vx_mem_free(args_buffer));
+      }
+    }
+    RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+    auto time_end = std::chrono::high_resolution_clock::now();
+
+    // download destination buffer
+    RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, buf_size));
+
+    // verify result
+    TYPE scale_sum = TYPE(num_launches * (num_launches + 1) / 2);
+    for (uint32_t i = 0; i < num_points; ++i) {
+      auto ref = scale_sum * h_src[i];
+      auto cur = h_dst[i];
+      if (cur != ref) {
+        if (*errors < 100) {
+          printf("*** error: [%d] expected=%d, actual=%d\n", i, ref, cur);
+        }
+        ++(*errors);
+      }
+    }
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() / double(num_launches);
+  };
+
+  int errors = 0;
+
+  std::cout << "run " << std::dec << num_launches << " launches with uploaded arguments" << std::endl;
+  auto upload_time = run_launches(false, &errors);
+
+  std::cout << "run " << std::dec << num_launches << " launches with the argument ring" << std::endl;
+  auto ring_time = run_launches(true, &errors);
+
+  printf("uploaded arguments: %.1f us/launch\n", upload_time);
+  printf("argument ring: %.1f us/launch\n", ring_time);
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
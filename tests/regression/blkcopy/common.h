@@ -0,0 +1,17 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#define COPY_NEWLIB 0
+#define COPY_WARP   1
+#define FILL_WARP   2
+
+typedef struct {
+  uint32_t mode;
+  uint32_t num_slices;
+  uint32_t slice_size;
+  uint32_t fill_value;
+  uint64_t src_addr;
+  uint64_t dst_addr;
+} kernel_arg_t;
+
+#endif
@@ -0,0 +1,34 @@
+#include <stdint.h>
+#include <string.h>
+#include <vx_intrinsics.h>
+#include <vx_memory.h>
+#include <vx_spawn.h>
+#include "common.h"
+
+// one task per thread, each warp moves one slice of the buffer
+void kernel_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<uint8_t*>(arg->src_addr);
+	auto dst_ptr = reinterpret_cast<uint8_t*>(arg->dst_addr);
+	uint32_t slice = task_id / vx_num_threads();
+	uint32_t offset = slice * arg->slice_size;
+
+	switch (arg->mode) {
+	case COPY_NEWLIB:
+		if (vx_thread_id() == 0) {
+			memcpy(dst_ptr + offset, src_ptr + offset, arg->slice_size);
+		}
+		break;
+	case COPY_WARP:
+		vx_memcpy_warp(dst_ptr + offset, src_ptr + offset, arg->slice_size);
+		break;
+	case FILL_WARP:
+		vx_memset_warp(dst_ptr + offset, arg->fill_value, arg->slice_size);
+		break;
+	}
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	vx_spawn_tasks(arg->num_slices * vx_num_threads(), (vx_spawn_tasks_cb)kernel_body, arg);
+	return 0;
+}
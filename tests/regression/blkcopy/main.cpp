@@ -0,0 +1,168 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <vortex.h>
+#include <VX_types.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t size = 65536;
+
+vx_device_h device = nullptr;
+vx_buffer_h src_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n bytes] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      size = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(src_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint64_t num_cores, num_warps;
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_CORES, &num_cores));
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_WARPS, &num_warps));
+
+  // one slice per warp, with an odd size to exercise the unaligned edges
+  uint32_t num_slices = num_cores * num_warps;
+  uint32_t slice_size = (size / num_slices) | 1;
+  uint32_t buf_size = num_slices * slice_size;
+
+  std::cout << "number of slices: " << num_slices << std::endl;
+  std::cout << "slice size: " << slice_size << " bytes" << std::endl;
+
+  kernel_arg.num_slices = num_slices;
+  kernel_arg.slice_size = slice_size;
+  kernel_arg.fill_value = 0x5a;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &src_buffer));
+  RT_CHECK(vx_mem_address(src_buffer, &kernel_arg.src_addr));
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  std::vector<uint8_t> h_src(buf_size);
+  std::vector<uint8_t> h_dst(buf_size);
+  for (uint32_t i = 0; i < buf_size; ++i) {
+    h_src[i] = std::rand();
+  }
+
+  std::cout << "upload source buffer" << std::endl;
+  RT_CHECK(vx_copy_to_dev(src_buffer, h_src.data(), 0, buf_size));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  RT_CHECK(vx_mem_alloc(device, sizeof(kernel_arg_t), VX_MEM_READ, &args_buffer));
+
+  static const char* mode_names[] = {"newlib memcpy", "vx_memcpy_warp", "vx_memset_warp"};
+
+  int errors = 0;
+
+  for (uint32_t mode = COPY_NEWLIB; mode <= FILL_WARP; ++mode) {
+    std::cout << "run " << mode_names[mode] << std::endl;
+
+    std::fill(h_dst.begin(), h_dst.end(), 0);
+    RT_CHECK(vx_copy_to_dev(dst_buffer, h_dst.data(), 0, buf_size));
+
+    kernel_arg.mode = mode;
+    RT_CHECK(vx_copy_to_dev(args_buffer, &kernel_arg, 0, sizeof(kernel_arg_t)));
+
+    RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+    RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+    uint64_t cycles = 0;
+    for (uint32_t core_id = 0; core_id < num_cores; ++core_id) {
+      uint64_t core_cycles;
+      RT_CHECK(vx_mpm_query(device, VX_CSR_MCYCLE, core_id, &core_cycles));
+      cycles = std::max(cycles, core_cycles);
+    }
+    std::cout << mode_names[mode] << ": " << cycles << " cycles, "
+              << (double(buf_size) / cycles) << " bytes/cycle" << std::endl;
+
+    // verify result
+    RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, buf_size));
+    for (uint32_t i = 0; i < buf_size; ++i) {
+      uint8_t ref = (mode == FILL_WARP) ? uint8_t(kernel_arg.fill_value) : h_src[i];
+      if (h_dst[i] != ref) {
+        if (errors < 100) {
+          printf("*** error: %s [%d] expected=%d, actual=%d\n", mode_names[mode], i, ref, h_dst[i]);
+        }
+        ++errors;
+      }
+    }
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
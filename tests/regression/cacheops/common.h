@@ -0,0 +1,22 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#define STREAM          0
+#define STREAM_PREFETCH 1
+#define MIXED           2
+#define MIXED_NA        3
+
+// lines fetched ahead of the one being summed
+#define PREFETCH_LINES  4
+
+typedef struct {
+  uint32_t mode;
+  uint32_t num_tasks;
+  uint32_t chunk_size;
+  uint32_t table_size;
+  uint64_t src_addr;
+  uint64_t table_addr;
+  uint64_t dst_addr;
+} kernel_arg_t;
+
+#endif
@@ -0,0 +1,77 @@
+#include <stdint.h>
+#include <VX_config.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include "common.h"
+
+#define LINE_WORDS (L1_LINE_SIZE / sizeof(int32_t))
+
+// each task sums its own chunk of the stream
+void stream_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<int32_t*>(arg->src_addr) + task_id * arg->chunk_size;
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	int32_t sum = 0;
+	for (uint32_t i = 0; i < arg->chunk_size; ++i) {
+		sum += src_ptr[i];
+	}
+	dst_ptr[task_id] = sum;
+}
+
+// same, with the lines PREFETCH_LINES ahead requested before summing a line
+void stream_prefetch_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<int32_t*>(arg->src_addr) + task_id * arg->chunk_size;
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	uint32_t chunk_size = arg->chunk_size;
+	for (uint32_t i = 0; i < PREFETCH_LINES * LINE_WORDS && i < chunk_size; i += LINE_WORDS) {
+		vx_prefetch_l1(src_ptr + i);
+	}
+	int32_t sum = 0;
+	for (uint32_t i = 0; i < chunk_size; i += LINE_WORDS) {
+		uint32_t ahead = i + PREFETCH_LINES * LINE_WORDS;
+		if (ahead < chunk_size) {
+			vx_prefetch_l1(src_ptr + ahead);
+		}
+		for (uint32_t j = i; j < i + LINE_WORDS && j < chunk_size; ++j) {
+			sum += src_ptr[j];
+		}
+	}
+	dst_ptr[task_id] = sum;
+}
+
+// table lookups indexed by a stream that is read once; the stream is read
+// with regular loads, or with no-allocate loads that leave the table cached
+void mixed_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<int32_t*>(arg->src_addr) + task_id * arg->chunk_size;
+	auto table_ptr = reinterpret_cast<int32_t*>(arg->table_addr);
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	uint32_t mask = arg->table_size - 1;
+	int32_t sum = 0;
+	for (uint32_t i = 0; i < arg->chunk_size; ++i) {
+		int32_t index = (arg->mode == MIXED_NA) ? vx_load_na(src_ptr + i) : src_ptr[i];
+		sum += table_ptr[index & mask];
+	}
+	dst_ptr[task_id] = sum;
+}
+
+// evict a buffer from every cache level so that each run starts cold
+static void flush_range(uint64_t addr, uint32_t size) {
+	auto ptr = reinterpret_cast<const uint8_t*>(addr);
+	for (uint32_t i = 0; i < size; i += L1_LINE_SIZE) {
+		vx_flush_line(ptr + i);
+	}
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	// each core flushes, the L1 caches are private to a socket
+	flush_range(arg->src_addr, arg->num_tasks * arg->chunk_size * sizeof(int32_t));
+	flush_range(arg->table_addr, arg->table_size * sizeof(int32_t));
+	vx_spawn_tasks_cb kernels[] = {
+		(vx_spawn_tasks_cb)stream_body,
+		(vx_spawn_tasks_cb)stream_prefetch_body,
+		(vx_spawn_tasks_cb)mixed_body,
+		(vx_spawn_tasks_cb)mixed_body
+	};
+	vx_spawn_tasks(arg->num_tasks, kernels[arg->mode], arg);
+	return 0;
+}
@@ -0,0 +1,212 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <vortex.h>
+#include <VX_types.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t size = 16384;
+uint32_t chunk_size = 256;
+uint32_t table_size = 2048;
+
+vx_device_h device = nullptr;
+vx_buffer_h src_buffer = nullptr;
+vx_buffer_h table_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n words] [-c chunk words] [-t table words] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:c:t:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      size = atoi(optarg);
+      break;
+    case 'c':
+      chunk_size = atoi(optarg);
+      break;
+    case 't':
+      table_size = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(src_buffer);
+    vx_mem_free(table_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  if (chunk_size == 0 || (size % chunk_size) != 0) {
+    std::cout << "Error: the stream size must be a multiple of the chunk size" << std::endl;
+    return -1;
+  }
+  if (table_size == 0 || (table_size & (table_size - 1)) != 0) {
+    std::cout << "Error: the table size must be a power of two" << std::endl;
+    return -1;
+  }
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint64_t num_cores;
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_CORES, &num_cores));
+
+  uint32_t num_tasks = size / chunk_size;
+  uint32_t src_buf_size = size * sizeof(int32_t);
+  uint32_t table_buf_size = table_size * sizeof(int32_t);
+  uint32_t dst_buf_size = num_tasks * sizeof(int32_t);
+
+  std::cout << "stream size: " << size << " words" << std::endl;
+  std::cout << "table size: " << table_size << " words" << std::endl;
+  std::cout << "number of tasks: " << num_tasks << std::endl;
+
+  kernel_arg.num_tasks = num_tasks;
+  kernel_arg.chunk_size = chunk_size;
+  kernel_arg.table_size = table_size;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, src_buf_size, VX_MEM_READ, &src_buffer));
+  RT_CHECK(vx_mem_address(src_buffer, &kernel_arg.src_addr));
+  RT_CHECK(vx_mem_alloc(device, table_buf_size, VX_MEM_READ, &table_buffer));
+  RT_CHECK(vx_mem_address(table_buffer, &kernel_arg.table_addr));
+  RT_CHECK(vx_mem_alloc(device, dst_buf_size, VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  std::vector<int32_t> h_src(size);
+  std::vector<int32_t> h_table(table_size);
+  std::vector<int32_t> h_dst(num_tasks);
+  for (uint32_t i = 0; i < size; ++i) {
+    h_src[i] = std::rand();
+  }
+  for (uint32_t i = 0; i < table_size; ++i) {
+    h_table[i] = (std::rand() % 200) - 100;
+  }
+
+  // per-task references
+  std::vector<int32_t> h_sums(num_tasks);
+  std::vector<int32_t> h_lookups(num_tasks);
+  for (uint32_t t = 0; t < num_tasks; ++t) {
+    int32_t sum = 0, lookup = 0;
+    for (uint32_t i = 0; i < chunk_size; ++i) {
+      int32_t value = h_src[t * chunk_size + i];
+      sum += value;
+      lookup += h_table[value & (table_size - 1)];
+    }
+    h_sums[t] = sum;
+    h_lookups[t] = lookup;
+  }
+
+  std::cout << "upload source buffers" << std::endl;
+  RT_CHECK(vx_copy_to_dev(src_buffer, h_src.data(), 0, src_buf_size));
+  RT_CHECK(vx_copy_to_dev(table_buffer, h_table.data(), 0, table_buf_size));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  RT_CHECK(vx_mem_alloc(device, sizeof(kernel_arg_t), VX_MEM_READ, &args_buffer));
+
+  static const char* mode_names[] = {"stream", "stream (prefetch)", "mixed", "mixed (no-allocate)"};
+
+  int errors = 0;
+  uint64_t cycles[4];
+
+  for (uint32_t mode = STREAM; mode <= MIXED_NA; ++mode) {
+    std::cout << "run " << mode_names[mode] << std::endl;
+
+    std::fill(h_dst.begin(), h_dst.end(), 0);
+    RT_CHECK(vx_copy_to_dev(dst_buffer, h_dst.data(), 0, dst_buf_size));
+
+    kernel_arg.mode = mode;
+    RT_CHECK(vx_copy_to_dev(args_buffer, &kernel_arg, 0, sizeof(kernel_arg_t)));
+
+    RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+    RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+    cycles[mode] = 0;
+    for (uint32_t core_id = 0; core_id < num_cores; ++core_id) {
+      uint64_t core_cycles;
+      RT_CHECK(vx_mpm_query(device, VX_CSR_MCYCLE, core_id, &core_cycles));
+      cycles[mode] = std::max(cycles[mode], core_cycles);
+    }
+
+    // verify result
+    RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, dst_buf_size));
+    bool is_mixed = (mode == MIXED || mode == MIXED_NA);
+    for (uint32_t i = 0; i < num_tasks; ++i) {
+      int32_t ref = is_mixed ? h_lookups[i] : h_sums[i];
+      if (h_dst[i] != ref) {
+        if (errors < 100) {
+          printf("*** error: %s [%d] expected=%d, actual=%d\n", mode_names[mode], i, ref, h_dst[i]);
+        }
+        ++errors;
+      }
+    }
+  }
+
+  for (uint32_t mode = STREAM; mode <= MIXED_NA; ++mode) {
+    std::cout << mode_names[mode] << ": " << cycles[mode] << " cycles" << std::endl;
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
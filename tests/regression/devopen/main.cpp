@@ -0,0 +1,143 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include <vortex.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t size = 64;
+uint32_t num_cycles = 8;
+
+vx_device_h device = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n words] [-r open/close cycles] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:r:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      size = atoi(optarg);
+      break;
+    case 'r':
+      num_cycles = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+    device = nullptr;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  if (num_cycles == 0) {
+    std::cout << "Error: invalid number of cycles!" << std::endl;
+    return -1;
+  }
+
+  uint32_t num_points = size;
+  uint32_t buf_size = num_points * sizeof(uint32_t);
+
+  std::cout << "number of points: " << num_points << std::endl;
+  std::cout << "open/close cycles: " << num_cycles << std::endl;
+
+  std::vector<uint32_t> h_dst(num_points);
+  std::vector<double> latencies;
+
+  int errors = 0;
+
+  for (uint32_t r = 0; r < num_cycles; ++r) {
+    // measure from device open to the first kernel completion
+    auto time_start = std::chrono::high_resolution_clock::now();
+
+    RT_CHECK(vx_dev_open(&device));
+
+    kernel_arg_t kernel_arg = {};
+    kernel_arg.num_points = num_points;
+    kernel_arg.value = r;
+    RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_WRITE, &dst_buffer));
+    RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+    RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+    RT_CHECK(vx_upload_bytes(device, &kernel_arg, sizeof(kernel_arg_t), &args_buffer));
+    RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+    RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+    auto time_end = std::chrono::high_resolution_clock::now();
+    latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() / 1000.0);
+
+    // verify result
+    RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, buf_size));
+    for (uint32_t i = 0; i < num_points; ++i) {
+      auto ref = r + i;
+      auto cur = h_dst[i];
+      if (cur != ref) {
+        if (errors < 100) {
+          printf("*** error: cycle %d: [%d] expected=%d, actual=%d\n", r, i, ref, cur);
+        }
+        ++errors;
+      }
+    }
+
+    cleanup();
+  }
+
+  double reopen_latency = 0;
+  for (uint32_t r = 1; r < num_cycles; ++r) {
+    reopen_latency += latencies[r];
+  }
+  printf("first open-to-kernel latency: %.3f ms\n", latencies[0]);
+  if (num_cycles > 1) {
+    printf("reopen-to-kernel latency: %.3f ms (average of %d)\n", reopen_latency / (num_cycles - 1), num_cycles - 1);
+  }
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
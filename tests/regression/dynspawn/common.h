@@ -0,0 +1,19 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#define SPAWN_STATIC  0
+#define SPAWN_DYN     1
+#define SPAWN_STEAL   2
+
+typedef struct {
+  uint32_t num_rows;
+  uint32_t num_cols;
+  uint32_t mode;
+  uint32_t chunk_size;
+  uint64_t row_len_addr;
+  uint64_t src_addr;
+  uint64_t dst_addr;
+  uint64_t counters_addr;
+} kernel_arg_t;
+
+#endif
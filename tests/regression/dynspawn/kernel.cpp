@@ -0,0 +1,35 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include "common.h"
+
+void kernel_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto row_len = reinterpret_cast<uint32_t*>(arg->row_len_addr);
+	auto src_ptr = reinterpret_cast<int32_t*>(arg->src_addr);
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	uint32_t num_cols = arg->num_cols;
+
+	int32_t sum = 0;
+	uint32_t len = row_len[task_id];
+	for (uint32_t j = 0; j < len; ++j) {
+		sum += src_ptr[(task_id + j) % num_cols];
+	}
+	dst_ptr[task_id] = sum;
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	auto counters = reinterpret_cast<int*>(arg->counters_addr);
+	switch (arg->mode) {
+	case SPAWN_DYN:
+		vx_spawn_tasks_dyn(arg->num_rows, arg->chunk_size, counters, (vx_spawn_tasks_cb)kernel_body, arg);
+		break;
+	case SPAWN_STEAL:
+		vx_spawn_tasks_steal(arg->num_rows, arg->chunk_size, counters, (vx_spawn_tasks_cb)kernel_body, arg);
+		break;
+	default:
+		vx_spawn_tasks(arg->num_rows, (vx_spawn_tasks_cb)kernel_body, arg);
+		break;
+	}
+	return 0;
+}
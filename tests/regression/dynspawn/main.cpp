@@ -0,0 +1,205 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <vortex.h>
+#include <VX_types.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t num_rows = 512;
+uint32_t heavy_len = 64;
+uint32_t chunk_size = 16;
+
+vx_device_h device = nullptr;
+vx_buffer_h row_len_buffer = nullptr;
+vx_buffer_h src_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h counters_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n rows] [-s heavy row length] [-c chunk size] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:s:c:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      num_rows = atoi(optarg);
+      break;
+    case 's':
+      heavy_len = atoi(optarg);
+      break;
+    case 'c':
+      chunk_size = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(row_len_buffer);
+    vx_mem_free(src_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(counters_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint64_t num_cores;
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_CORES, &num_cores));
+
+  uint32_t num_cols = num_rows;
+  uint32_t buf_size = num_rows * sizeof(int32_t);
+  uint32_t counters_size = num_cores * sizeof(int32_t);
+
+  std::cout << "number of rows: " << num_rows << std::endl;
+  std::cout << "heavy row length: " << heavy_len << std::endl;
+  std::cout << "chunk size: " << chunk_size << std::endl;
+
+  kernel_arg.num_rows = num_rows;
+  kernel_arg.num_cols = num_cols;
+  kernel_arg.chunk_size = chunk_size;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &row_len_buffer));
+  RT_CHECK(vx_mem_address(row_len_buffer, &kernel_arg.row_len_addr));
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &src_buffer));
+  RT_CHECK(vx_mem_address(src_buffer, &kernel_arg.src_addr));
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+  RT_CHECK(vx_mem_alloc(device, counters_size, VX_MEM_READ_WRITE, &counters_buffer));
+  RT_CHECK(vx_mem_address(counters_buffer, &kernel_arg.counters_addr));
+
+  // skewed input: the first eighth of the rows carries most of the work,
+  // which lands entirely on core0 under the static split
+  std::vector<uint32_t> h_row_len(num_rows);
+  std::vector<int32_t> h_src(num_cols);
+  std::vector<int32_t> h_dst(num_rows);
+  std::vector<int32_t> h_zeros(std::max(num_rows, (uint32_t)num_cores), 0);
+
+  for (uint32_t i = 0; i < num_rows; ++i) {
+    h_row_len[i] = (i < num_rows / 8) ? heavy_len : 1;
+  }
+  for (uint32_t i = 0; i < num_cols; ++i) {
+    h_src[i] = std::rand() % 100;
+  }
+
+  std::vector<int32_t> h_ref(num_rows);
+  for (uint32_t i = 0; i < num_rows; ++i) {
+    int32_t sum = 0;
+    for (uint32_t j = 0; j < h_row_len[i]; ++j) {
+      sum += h_src[(i + j) % num_cols];
+    }
+    h_ref[i] = sum;
+  }
+
+  std::cout << "upload source buffers" << std::endl;
+  RT_CHECK(vx_copy_to_dev(row_len_buffer, h_row_len.data(), 0, buf_size));
+  RT_CHECK(vx_copy_to_dev(src_buffer, h_src.data(), 0, buf_size));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  RT_CHECK(vx_mem_alloc(device, sizeof(kernel_arg_t), VX_MEM_READ, &args_buffer));
+
+  static const char* mode_names[] = {"static", "dynamic", "stealing"};
+
+  int errors = 0;
+  uint64_t cycles[3];
+
+  for (uint32_t mode = SPAWN_STATIC; mode <= SPAWN_STEAL; ++mode) {
+    std::cout << "run " << mode_names[mode] << " schedule" << std::endl;
+
+    // each launch consumes its counters
+    RT_CHECK(vx_copy_to_dev(counters_buffer, h_zeros.data(), 0, counters_size));
+    RT_CHECK(vx_copy_to_dev(dst_buffer, h_zeros.data(), 0, buf_size));
+
+    kernel_arg.mode = mode;
+    RT_CHECK(vx_copy_to_dev(args_buffer, &kernel_arg, 0, sizeof(kernel_arg_t)));
+
+    RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+    RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+    // the launch lasts as long as its slowest core
+    cycles[mode] = 0;
+    for (uint32_t core_id = 0; core_id < num_cores; ++core_id) {
+      uint64_t core_cycles;
+      RT_CHECK(vx_mpm_query(device, VX_CSR_MCYCLE, core_id, &core_cycles));
+      cycles[mode] = std::max(cycles[mode], core_cycles);
+    }
+
+    // verify result
+    RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, buf_size));
+    for (uint32_t i = 0; i < num_rows; ++i) {
+      if (h_dst[i] != h_ref[i]) {
+        if (errors < 100) {
+          printf("*** error: %s [%d] expected=%d, actual=%d\n", mode_names[mode], i, h_ref[i], h_dst[i]);
+        }
+        ++errors;
+      }
+    }
+  }
+
+  for (uint32_t mode = SPAWN_STATIC; mode <= SPAWN_STEAL; ++mode) {
+    std::cout << mode_names[mode] << " schedule: " << cycles[mode] << " cycles" << std::endl;
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,16 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#ifndef TYPE
+#define TYPE int
+#endif
+
+typedef struct {
+  uint32_t num_points;
+  uint32_t num_clusters;
+  uint64_t points_addr;
+  uint64_t centroids_addr;
+  uint64_t labels_addr;
+} kernel_arg_t;
+
+#endif
@@ -0,0 +1,31 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include "common.h"
+
+void kernel_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto points_ptr    = reinterpret_cast<TYPE*>(arg->points_addr);
+	auto centroids_ptr = reinterpret_cast<TYPE*>(arg->centroids_addr);
+	auto labels_ptr    = reinterpret_cast<uint32_t*>(arg->labels_addr);
+
+	// assign the point to its nearest centroid
+	TYPE point = points_ptr[task_id];
+	uint32_t label = 0;
+	TYPE min_dist = 0;
+	for (uint32_t k = 0; k < arg->num_clusters; ++k) {
+		TYPE diff = point - centroids_ptr[k];
+		TYPE dist = diff * diff;
+		if (k == 0 || dist < min_dist) {
+			min_dist = dist;
+			label = k;
+		}
+	}
+
+	labels_ptr[task_id] = label;
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	vx_spawn_tasks(arg->num_points, (vx_spawn_tasks_cb)kernel_body, arg);
+	return 0;
+}
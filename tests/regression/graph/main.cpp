@@ -0,0 +1,240 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include <vortex.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t num_points = 256;
+uint32_t num_clusters = 4;
+uint32_t num_iterations = 16;
+
+vx_device_h device = nullptr;
+vx_buffer_h points_buffer = nullptr;
+vx_buffer_h centroids_buffer = nullptr;
+vx_buffer_h labels_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+vx_graph_h graph = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n points] [-c clusters] [-i iterations] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:c:i:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      num_points = atoi(optarg);
+      break;
+    case 'c':
+      num_clusters = atoi(optarg);
+      break;
+    case 'i':
+      num_iterations = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_graph_destroy(graph);
+    vx_mem_free(points_buffer);
+    vx_mem_free(centroids_buffer);
+    vx_mem_free(labels_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+static uint32_t nearest_centroid(TYPE point, const std::vector<TYPE>& centroids) {
+  uint32_t label = 0;
+  TYPE min_dist = 0;
+  for (uint32_t k = 0; k < centroids.size(); ++k) {
+    TYPE diff = point - centroids[k];
+    TYPE dist = diff * diff;
+    if (k == 0 || dist < min_dist) {
+      min_dist = dist;
+      label = k;
+    }
+  }
+  return label;
+}
+
+// move each centroid to the mean of its assigned points
+static void update_centroids(const std::vector<TYPE>& points, const std::vector<uint32_t>& labels, std::vector<TYPE>& centroids) {
+  std::vector<TYPE> sums(centroids.size(), 0);
+  std::vector<uint32_t> counts(centroids.size(), 0);
+  for (uint32_t i = 0; i < points.size(); ++i) {
+    sums[labels[i]] += points[i];
+    ++counts[labels[i]];
+  }
+  for (uint32_t k = 0; k < centroids.size(); ++k) {
+    if (counts[k] != 0) {
+      centroids[k] = sums[k] / TYPE(counts[k]);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  if (num_clusters == 0 || num_clusters > num_points) {
+    std::cout << "Error: invalid number of clusters!" << std::endl;
+    return -1;
+  }
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint32_t points_size = num_points * sizeof(TYPE);
+  uint32_t centroids_size = num_clusters * sizeof(TYPE);
+  uint32_t labels_size = num_points * sizeof(uint32_t);
+
+  std::cout << "number of points: " << num_points << std::endl;
+  std::cout << "number of clusters: " << num_clusters << std::endl;
+  std::cout << "number of iterations: " << num_iterations << std::endl;
+
+  kernel_arg.num_points = num_points;
+  kernel_arg.num_clusters = num_clusters;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, points_size, VX_MEM_READ, &points_buffer));
+  RT_CHECK(vx_mem_address(points_buffer, &kernel_arg.points_addr));
+  RT_CHECK(vx_mem_alloc(device, centroids_size, VX_MEM_READ, &centroids_buffer));
+  RT_CHECK(vx_mem_address(centroids_buffer, &kernel_arg.centroids_addr));
+  RT_CHECK(vx_mem_alloc(device, labels_size, VX_MEM_WRITE, &labels_buffer));
+  RT_CHECK(vx_mem_address(labels_buffer, &kernel_arg.labels_addr));
+
+  // generate points
+  std::vector<TYPE> h_points(num_points);
+  for (uint32_t i = 0; i < num_points; ++i) {
+    h_points[i] = std::rand() % 1024;
+  }
+
+  std::vector<TYPE> init_centroids(h_points.begin(), h_points.begin() + num_clusters);
+  std::vector<TYPE> h_centroids(num_clusters);
+  std::vector<uint32_t> h_labels(num_points);
+
+  // upload points
+  std::cout << "upload points" << std::endl;
+  RT_CHECK(vx_copy_to_dev(points_buffer, h_points.data(), 0, points_size));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  // upload kernel argument
+  std::cout << "upload kernel argument" << std::endl;
+  RT_CHECK(vx_upload_bytes(device, &kernel_arg, sizeof(kernel_arg_t), &args_buffer));
+
+  // capture one iteration: centroids upload, assignment kernel, labels download
+  std::cout << "capture graph" << std::endl;
+  RT_CHECK(vx_graph_create(device, &graph));
+  RT_CHECK(vx_graph_copy_to_dev(graph, centroids_buffer, h_centroids.data(), 0, centroids_size));
+  RT_CHECK(vx_graph_start(graph, krnl_buffer, args_buffer));
+  RT_CHECK(vx_graph_copy_from_dev(graph, h_labels.data(), labels_buffer, 0, labels_size));
+
+  // run the clustering loop and return the average host time per iteration
+  auto run_kmeans = [&](bool use_graph)->double {
+    h_centroids = init_centroids;
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < num_iterations; ++i) {
+      if (use_graph) {
+        RT_CHECK(vx_graph_launch(graph));
+        RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+      } else {
+        RT_CHECK(vx_copy_to_dev(centroids_buffer, h_centroids.data(), 0, centroids_size));
+        RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+        RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+        RT_CHECK(vx_copy_from_dev(h_labels.data(), labels_buffer, 0, labels_size));
+      }
+      update_centroids(h_points, h_labels, h_centroids);
+    }
+    auto time_end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() / double(num_iterations);
+  };
+
+  // host reference
+  std::vector<TYPE> ref_centroids(init_centroids);
+  std::vector<uint32_t> ref_labels(num_points);
+  for (uint32_t i = 0; i < num_iterations; ++i) {
+    for (uint32_t j = 0; j < num_points; ++j) {
+      ref_labels[j] = nearest_centroid(h_points[j], ref_centroids);
+    }
+    update_centroids(h_points, ref_labels, ref_centroids);
+  }
+
+  int errors = 0;
+  auto verify = [&](const char* mode) {
+    for (uint32_t k = 0; k < num_clusters; ++k) {
+      if (h_centroids[k] != ref_centroids[k]) {
+        if (errors < 100) {
+          printf("*** error: %s centroid[%d] expected=%d, actual=%d\n", mode, k, ref_centroids[k], h_centroids[k]);
+        }
+        ++errors;
+      }
+    }
+  };
+
+  std::cout << "run " << std::dec << num_iterations << " iterations with individual calls" << std::endl;
+  auto calls_time = run_kmeans(false);
+  verify("calls");
+
+  std::cout << "run " << std::dec << num_iterations << " iterations with graph replay" << std::endl;
+  auto graph_time = run_kmeans(true);
+  verify("graph");
+
+  printf("individual calls: %.1f us/iteration\n", calls_time);
+  printf("graph replay: %.1f us/iteration\n", graph_time);
+  printf("overhead reduction: %.1f us/iteration\n", calls_time - graph_time);
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
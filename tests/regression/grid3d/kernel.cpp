@@ -0,0 +1,35 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include "common.h"
+
+void kernel_body(kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<TYPE*>(arg->src_addr);
+	auto dst_ptr = reinterpret_cast<TYPE*>(arg->dst_addr);
+	auto local_ptr = reinterpret_cast<TYPE*>(vx_local_mem());
+
+	uint32_t width  = gridDim.x * blockDim.x;
+	uint32_t height = gridDim.y * blockDim.y;
+	uint32_t gid = (globalIdx.z * height + globalIdx.y) * width + globalIdx.x;
+
+	uint32_t block_size = blockDim.x * blockDim.y * blockDim.z;
+	uint32_t lid = (threadIdx.z * blockDim.y + threadIdx.y) * blockDim.x + threadIdx.x;
+
+	// stage the block in local memory
+	local_ptr[lid] = src_ptr[gid];
+
+	__syncthreads();
+
+	// add the value of the next thread in the block
+	dst_ptr[gid] = local_ptr[lid] + local_ptr[(lid + 1) % block_size];
+
+	// keep the next block on this slot from overwriting the tile early
+	__syncthreads();
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	uint32_t block_size = arg->block_dim[0] * arg->block_dim[1] * arg->block_dim[2];
+	vx_spawn_threads(3, arg->grid_dim, arg->block_dim, block_size * sizeof(TYPE), (vx_spawn_threads_cb)kernel_body, arg);
+	return 0;
+}
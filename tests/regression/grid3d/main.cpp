@@ -0,0 +1,181 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <vortex.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t global_dim[3] = {16, 8, 4};
+
+vx_device_h device = nullptr;
+vx_buffer_h src_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-x width] [-y height] [-z depth] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "x:y:z:k:h?")) != -1) {
+    switch (c) {
+    case 'x':
+      global_dim[0] = atoi(optarg);
+      break;
+    case 'y':
+      global_dim[1] = atoi(optarg);
+      break;
+    case 'z':
+      global_dim[2] = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(src_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint32_t num_points = global_dim[0] * global_dim[1] * global_dim[2];
+  uint32_t buf_size = num_points * sizeof(TYPE);
+
+  std::cout << "grid size: " << global_dim[0] << "x" << global_dim[1] << "x" << global_dim[2] << std::endl;
+
+  // let the runtime pick the block shape
+  RT_CHECK(vx_pick_block_dim(device, 3, global_dim, sizeof(TYPE), kernel_arg.block_dim));
+  for (int d = 0; d < 3; ++d) {
+    kernel_arg.grid_dim[d] = global_dim[d] / kernel_arg.block_dim[d];
+  }
+  uint32_t block_size = kernel_arg.block_dim[0] * kernel_arg.block_dim[1] * kernel_arg.block_dim[2];
+  std::cout << "block shape: " << kernel_arg.block_dim[0] << "x" << kernel_arg.block_dim[1] << "x" << kernel_arg.block_dim[2] << std::endl;
+  std::cout << "number of blocks: " << (num_points / block_size) << std::endl;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &src_buffer));
+  RT_CHECK(vx_mem_address(src_buffer, &kernel_arg.src_addr));
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  std::cout << "dev_src=0x" << std::hex << kernel_arg.src_addr << std::endl;
+  std::cout << "dev_dst=0x" << std::hex << kernel_arg.dst_addr << std::dec << std::endl;
+
+  // allocate host buffers
+  std::cout << "allocate host buffers" << std::endl;
+  std::vector<TYPE> h_src(num_points);
+  std::vector<TYPE> h_dst(num_points);
+  for (uint32_t i = 0; i < num_points; ++i) {
+    h_src[i] = std::rand() % 1000;
+  }
+
+  // upload source buffer
+  std::cout << "upload source buffer" << std::endl;
+  RT_CHECK(vx_copy_to_dev(src_buffer, h_src.data(), 0, buf_size));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  // upload kernel argument
+  std::cout << "upload kernel argument" << std::endl;
+  RT_CHECK(vx_upload_bytes(device, &kernel_arg, sizeof(kernel_arg_t), &args_buffer));
+
+  // start device
+  std::cout << "start device" << std::endl;
+  RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+
+  // wait for completion
+  std::cout << "wait for completion" << std::endl;
+  RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+  // download destination buffer
+  std::cout << "download destination buffer" << std::endl;
+  RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, buf_size));
+
+  // verify result
+  std::cout << "verify result" << std::endl;
+  int errors = 0;
+  {
+    const uint32_t* bd = kernel_arg.block_dim;
+    for (uint32_t z = 0; z < global_dim[2]; ++z) {
+      for (uint32_t y = 0; y < global_dim[1]; ++y) {
+        for (uint32_t x = 0; x < global_dim[0]; ++x) {
+          // neighbor within the block, in block-linear order
+          uint32_t bx = x - x % bd[0], by = y - y % bd[1], bz = z - z % bd[2];
+          uint32_t lid = ((z % bd[2]) * bd[1] + (y % bd[1])) * bd[0] + (x % bd[0]);
+          uint32_t nid = (lid + 1) % block_size;
+          uint32_t nx = bx + nid % bd[0];
+          uint32_t ny = by + (nid / bd[0]) % bd[1];
+          uint32_t nz = bz + nid / (bd[0] * bd[1]);
+          uint32_t i = (z * global_dim[1] + y) * global_dim[0] + x;
+          uint32_t n = (nz * global_dim[1] + ny) * global_dim[0] + nx;
+          TYPE ref = h_src[i] + h_src[n];
+          if (h_dst[i] != ref) {
+            if (errors < 100) {
+              printf("*** error: [%d,%d,%d] expected=%d, actual=%d\n", x, y, z, ref, h_dst[i]);
+            }
+            ++errors;
+          }
+        }
+      }
+    }
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return errors;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#define MAX_BLOCKS      32
+#define MAX_BLOCK_WORDS 64
+
+typedef struct {
+  uint32_t num_tasks;
+  uint32_t num_rounds;
+  uint32_t num_blocks;
+  uint64_t dst_addr;
+} kernel_arg_t;
+
+#endif
@@ -0,0 +1,52 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include <vx_memory.h>
+#include "common.h"
+
+void kernel_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto dst_ptr = reinterpret_cast<uint32_t*>(arg->dst_addr);
+
+	uint32_t* blocks[MAX_BLOCKS];
+	uint32_t sizes[MAX_BLOCKS];
+	uint32_t num_blocks = arg->num_blocks;
+	uint32_t errors = 0;
+
+	for (uint32_t r = 0; r < arg->num_rounds; ++r) {
+		// allocate blocks of varying sizes and tag them
+		for (uint32_t i = 0; i < num_blocks; ++i) {
+			uint32_t words = 1 + ((task_id + i * 7 + r * 3) % MAX_BLOCK_WORDS);
+			auto block = reinterpret_cast<uint32_t*>(vx_malloc(words * sizeof(uint32_t)));
+			blocks[i] = block;
+			sizes[i] = words;
+			if (block == nullptr) {
+				++errors;
+				continue;
+			}
+			for (uint32_t w = 0; w < words; ++w) {
+				block[w] = (task_id << 16) ^ (i << 8) ^ w;
+			}
+		}
+		// check that no other thread overwrote them, then release them
+		for (uint32_t i = 0; i < num_blocks; ++i) {
+			auto block = blocks[i];
+			if (block == nullptr)
+				continue;
+			for (uint32_t w = 0; w < sizes[i]; ++w) {
+				if (block[w] != ((task_id << 16) ^ (i << 8) ^ w)) {
+					++errors;
+					break;
+				}
+			}
+			vx_free(block);
+		}
+	}
+
+	dst_ptr[task_id] = errors;
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	vx_spawn_tasks(arg->num_tasks, (vx_spawn_tasks_cb)kernel_body, arg);
+	return 0;
+}
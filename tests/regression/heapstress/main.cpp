@@ -0,0 +1,169 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <vortex.h>
+#include <VX_types.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t tasks_per_thread = 4;
+uint32_t num_rounds = 4;
+uint32_t num_blocks = 16;
+
+vx_device_h device = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h heap_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n tasks per thread] [-r rounds] [-b blocks per round] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:r:b:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      tasks_per_thread = atoi(optarg);
+      break;
+    case 'r':
+      num_rounds = atoi(optarg);
+      break;
+    case 'b':
+      num_blocks = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+  if (num_blocks == 0 || num_blocks > MAX_BLOCKS) {
+    std::cout << "Error: blocks per round must be in [1, " << MAX_BLOCKS << "]" << std::endl;
+    exit(-1);
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(dst_buffer);
+    vx_mem_free(heap_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint64_t num_cores, num_warps, num_threads;
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_CORES, &num_cores));
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_WARPS, &num_warps));
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_THREADS, &num_threads));
+
+  uint32_t total_threads = num_cores * num_warps * num_threads;
+  uint32_t num_tasks = total_threads * tasks_per_thread;
+  uint32_t buf_size = num_tasks * sizeof(uint32_t);
+
+  // every thread keeps at most one round of blocks live,
+  // each rounded up to a 512-byte size class
+  uint64_t heap_size = uint64_t(total_threads) * num_blocks * 512 * 2;
+
+  std::cout << "number of tasks: " << num_tasks << std::endl;
+  std::cout << "heap size: " << heap_size << " bytes" << std::endl;
+
+  kernel_arg.num_tasks = num_tasks;
+  kernel_arg.num_rounds = num_rounds;
+  kernel_arg.num_blocks = num_blocks;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  // assign the device heap
+  std::cout << "allocate device heap" << std::endl;
+  RT_CHECK(vx_kernel_heap(device, krnl_buffer, heap_size, &heap_buffer));
+
+  // upload kernel argument
+  std::cout << "upload kernel argument" << std::endl;
+  RT_CHECK(vx_upload_bytes(device, &kernel_arg, sizeof(kernel_arg_t), &args_buffer));
+
+  // start device
+  std::cout << "start device" << std::endl;
+  RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+
+  // wait for completion
+  std::cout << "wait for completion" << std::endl;
+  RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+  uint64_t cycles;
+  RT_CHECK(vx_mpm_query(device, VX_CSR_MCYCLE, 0, &cycles));
+  uint64_t num_allocs = uint64_t(num_tasks) * num_rounds * num_blocks;
+  std::cout << "allocations: " << num_allocs << ", cycles: " << cycles
+            << ", cycles per allocation: " << double(cycles) / num_allocs << std::endl;
+
+  // download destination buffer
+  std::cout << "download destination buffer" << std::endl;
+  std::vector<uint32_t> h_dst(num_tasks);
+  RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, buf_size));
+
+  // verify result
+  std::cout << "verify result" << std::endl;
+  int errors = 0;
+  for (uint32_t i = 0; i < num_tasks; ++i) {
+    if (h_dst[i] != 0) {
+      if (errors < 100) {
+        printf("*** error: task %d found %d bad blocks\n", i, h_dst[i]);
+      }
+      ++errors;
+    }
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return errors;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,16 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#define MODE_CALLBACK 0
+#define MODE_INLINE   1
+
+typedef struct {
+  uint32_t mode;
+  uint32_t num_tasks;
+  int32_t  alpha;
+  uint64_t src0_addr;
+  uint64_t src1_addr;
+  uint64_t dst_addr;
+} kernel_arg_t;
+
+#endif
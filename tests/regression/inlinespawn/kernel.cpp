@@ -0,0 +1,27 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.hpp>
+#include "common.h"
+
+void kernel_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto src0_ptr = reinterpret_cast<int32_t*>(arg->src0_addr);
+	auto src1_ptr = reinterpret_cast<int32_t*>(arg->src1_addr);
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	dst_ptr[task_id] = arg->alpha * src0_ptr[task_id] + src1_ptr[task_id];
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	if (arg->mode == MODE_INLINE) {
+		auto src0_ptr = reinterpret_cast<int32_t*>(arg->src0_addr);
+		auto src1_ptr = reinterpret_cast<int32_t*>(arg->src1_addr);
+		auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+		int32_t alpha = arg->alpha;
+		vx_spawn_tasks(arg->num_tasks, [=](int task_id) {
+			dst_ptr[task_id] = alpha * src0_ptr[task_id] + src1_ptr[task_id];
+		});
+	} else {
+		vx_spawn_tasks(arg->num_tasks, (vx_spawn_tasks_cb)kernel_body, arg);
+	}
+	return 0;
+}
@@ -0,0 +1,184 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <vortex.h>
+#include <VX_types.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t count = 16;
+uint32_t num_tasks = 0;
+
+vx_device_h device = nullptr;
+vx_buffer_h src0_buffer = nullptr;
+vx_buffer_h src1_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n tasks per thread] [-t total tasks] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:t:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      count = atoi(optarg);
+      break;
+    case 't':
+      num_tasks = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(src0_buffer);
+    vx_mem_free(src1_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint64_t num_cores, num_warps, num_threads;
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_CORES, &num_cores));
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_WARPS, &num_warps));
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_THREADS, &num_threads));
+
+  // one task per point, so the per-task overhead dominates;
+  // -t sets a total that need not divide evenly across cores and threads
+  uint32_t num_points = num_tasks ? num_tasks : (count * num_cores * num_warps * num_threads);
+  uint32_t buf_size = num_points * sizeof(int32_t);
+
+  std::cout << "number of points: " << num_points << std::endl;
+
+  kernel_arg.num_tasks = num_points;
+  kernel_arg.alpha = 3;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &src0_buffer));
+  RT_CHECK(vx_mem_address(src0_buffer, &kernel_arg.src0_addr));
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &src1_buffer));
+  RT_CHECK(vx_mem_address(src1_buffer, &kernel_arg.src1_addr));
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  // generate source data
+  std::vector<int32_t> h_src0(num_points);
+  std::vector<int32_t> h_src1(num_points);
+  std::vector<int32_t> h_dst(num_points);
+  for (uint32_t i = 0; i < num_points; ++i) {
+    h_src0[i] = rand() % 1000;
+    h_src1[i] = rand() % 1000;
+  }
+
+  // upload source buffers
+  std::cout << "upload source buffers" << std::endl;
+  RT_CHECK(vx_copy_to_dev(src0_buffer, h_src0.data(), 0, buf_size));
+  RT_CHECK(vx_copy_to_dev(src1_buffer, h_src1.data(), 0, buf_size));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  RT_CHECK(vx_mem_alloc(device, sizeof(kernel_arg_t), VX_MEM_READ, &args_buffer));
+
+  int errors = 0;
+
+  // run the kernel in the given spawn mode, return core0's instructions and cycles
+  auto run_mode = [&](uint32_t mode, uint64_t* instrs, uint64_t* cycles) {
+    kernel_arg.mode = mode;
+    RT_CHECK(vx_copy_to_dev(args_buffer, &kernel_arg, 0, sizeof(kernel_arg_t)));
+
+    // clear destination buffer
+    std::fill(h_dst.begin(), h_dst.end(), 0);
+    RT_CHECK(vx_copy_to_dev(dst_buffer, h_dst.data(), 0, buf_size));
+
+    RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+    RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+    RT_CHECK(vx_mpm_query(device, VX_CSR_MINSTRET, 0, instrs));
+    RT_CHECK(vx_mpm_query(device, VX_CSR_MCYCLE, 0, cycles));
+
+    // verify result
+    RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, buf_size));
+    for (uint32_t i = 0; i < num_points; ++i) {
+      int32_t ref = kernel_arg.alpha * h_src0[i] + h_src1[i];
+      int32_t cur = h_dst[i];
+      if (cur != ref) {
+        if (errors < 100) {
+          printf("*** error: mode %d [%d] expected=%d, actual=%d\n", mode, i, ref, cur);
+        }
+        ++errors;
+      }
+    }
+  };
+
+  uint64_t cb_instrs, cb_cycles;
+  std::cout << "run function pointer spawn" << std::endl;
+  run_mode(MODE_CALLBACK, &cb_instrs, &cb_cycles);
+
+  uint64_t inl_instrs, inl_cycles;
+  std::cout << "run inlined spawn" << std::endl;
+  run_mode(MODE_INLINE, &inl_instrs, &inl_cycles);
+
+  std::cout << "function pointer: instrs=" << cb_instrs << ", cycles=" << cb_cycles << std::endl;
+  std::cout << "inlined: instrs=" << inl_instrs << ", cycles=" << inl_cycles << std::endl;
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return errors;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
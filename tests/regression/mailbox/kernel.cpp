@@ -0,0 +1,24 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include <vx_mailbox.h>
+#include "common.h"
+
+void kernel_body(int task_id, work_desc_t* __UNIFORM__ work) {
+	auto src0_ptr = reinterpret_cast<TYPE*>(work->src0_addr);
+	auto src1_ptr = reinterpret_cast<TYPE*>(work->src1_addr);
+	auto dst_ptr  = reinterpret_cast<TYPE*>(work->dst_addr);
+
+	dst_ptr[task_id] = src0_ptr[task_id] + src1_ptr[task_id];
+}
+
+void process_work(const void* desc, void* arg) {
+	auto work = (work_desc_t*)desc;
+	vx_spawn_tasks(work->num_points, (vx_spawn_tasks_cb)kernel_body, work);
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	vx_mailbox_serve((const void*)arg->mailbox_addr, process_work, arg);
+	return 0;
+}
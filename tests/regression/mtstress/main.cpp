@@ -0,0 +1,228 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <vortex.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+// worker threads report failures to their caller instead of exiting
+#define RT_THREAD_CHECK(_expr)                                  \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+     return -1;                                                 \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t size = 64;
+uint32_t max_threads = 4;
+uint32_t num_launches = 8;
+
+std::vector<vx_device_h> devices;
+std::vector<vx_buffer_h> krnl_buffers;
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n words] [-t threads] [-r launches per thread] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:t:r:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      size = atoi(optarg);
+      break;
+    case 't':
+      max_threads = atoi(optarg);
+      break;
+    case 'r':
+      num_launches = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  for (auto krnl_buffer : krnl_buffers) {
+    vx_mem_free(krnl_buffer);
+  }
+  for (auto device : devices) {
+    vx_dev_close(device);
+  }
+}
+
+// per-thread device buffers
+struct thread_ctx_t {
+  vx_buffer_h src_buffer = nullptr;
+  vx_buffer_h dst_buffer = nullptr;
+  vx_buffer_h args_buffer = nullptr;
+  ~thread_ctx_t() {
+    vx_mem_free(src_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(args_buffer);
+  }
+};
+
+// issue copies and launches on a shared device, count mismatches into errors
+static int run_worker(uint32_t tid, uint32_t* errors) {
+  uint32_t dev_index = tid % devices.size();
+  auto device = devices.at(dev_index);
+  auto krnl_buffer = krnl_buffers.at(dev_index);
+
+  uint32_t num_points = size;
+  uint32_t buf_size = num_points * sizeof(TYPE);
+
+  thread_ctx_t ctx;
+  kernel_arg_t kernel_arg = {};
+  kernel_arg.num_points = num_points;
+
+  RT_THREAD_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &ctx.src_buffer));
+  RT_THREAD_CHECK(vx_mem_address(ctx.src_buffer, &kernel_arg.src_addr));
+  RT_THREAD_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_WRITE, &ctx.dst_buffer));
+  RT_THREAD_CHECK(vx_mem_address(ctx.dst_buffer, &kernel_arg.dst_addr));
+  RT_THREAD_CHECK(vx_mem_alloc(device, sizeof(kernel_arg_t), VX_MEM_READ, &ctx.args_buffer));
+
+  std::vector<TYPE> h_src(num_points);
+  std::vector<TYPE> h_dst(num_points);
+
+  uint32_t seed = tid;
+  for (uint32_t r = 0; r < num_launches; ++r) {
+    for (uint32_t i = 0; i < num_points; ++i) {
+      h_src[i] = rand_r(&seed) % 1024;
+    }
+    kernel_arg.value = tid * num_launches + r;
+
+    RT_THREAD_CHECK(vx_copy_to_dev(ctx.src_buffer, h_src.data(), 0, buf_size));
+    RT_THREAD_CHECK(vx_copy_to_dev(ctx.args_buffer, &kernel_arg, 0, sizeof(kernel_arg_t)));
+    RT_THREAD_CHECK(vx_start(device, krnl_buffer, ctx.args_buffer));
+    RT_THREAD_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+    RT_THREAD_CHECK(vx_copy_from_dev(h_dst.data(), ctx.dst_buffer, 0, buf_size));
+
+    for (uint32_t i = 0; i < num_points; ++i) {
+      auto ref = h_src[i] + kernel_arg.value;
+      auto cur = h_dst[i];
+      if (cur != ref) {
+        if (*errors < 100) {
+          printf("*** error: thread %d, launch %d: [%d] expected=%d, actual=%d\n", tid, r, i, ref, cur);
+        }
+        ++(*errors);
+      }
+    }
+  }
+
+  return 0;
+}
+
+// run the workers concurrently and return the launch throughput
+static double run_threads(uint32_t num_threads, std::atomic<int>* errors) {
+  std::vector<std::thread> threads;
+  std::vector<uint32_t> thread_errors(num_threads, 0);
+  std::vector<int> thread_status(num_threads, 0);
+
+  auto time_start = std::chrono::high_resolution_clock::now();
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      thread_status[t] = run_worker(t, &thread_errors[t]);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto time_end = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    if (thread_status[t] != 0) {
+      cleanup();
+      exit(-1);
+    }
+    *errors += thread_errors[t];
+  }
+
+  double elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() / 1e6;
+  return (num_threads * num_launches) / elapsed;
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  if (max_threads == 0) {
+    std::cout << "Error: invalid number of threads!" << std::endl;
+    return -1;
+  }
+
+  uint32_t num_devices;
+  RT_CHECK(vx_dev_count(&num_devices));
+  num_devices = std::min(num_devices, max_threads);
+
+  std::cout << "number of points: " << size << std::endl;
+  std::cout << "number of host threads: " << max_threads << std::endl;
+  std::cout << "launches per thread: " << num_launches << std::endl;
+  std::cout << "number of devices: " << num_devices << std::endl;
+
+  // open devices and upload the program to each of them
+  for (uint32_t d = 0; d < num_devices; ++d) {
+    vx_device_h device;
+    RT_CHECK(vx_dev_open_index(d, &device));
+    devices.push_back(device);
+    vx_buffer_h krnl_buffer;
+    RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+    krnl_buffers.push_back(krnl_buffer);
+  }
+
+  std::atomic<int> errors(0);
+
+  std::cout << "run with 1 host thread" << std::endl;
+  auto base_rate = run_threads(1, &errors);
+
+  std::cout << "run with " << max_threads << " host threads" << std::endl;
+  auto mt_rate = run_threads(max_threads, &errors);
+
+  printf("1 thread: %.1f launches/s\n", base_rate);
+  printf("%d threads: %.1f launches/s\n", max_threads, mt_rate);
+  printf("throughput scaling: %.2fx\n", mt_rate / base_rate);
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
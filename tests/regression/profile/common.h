@@ -0,0 +1,19 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#define MAX_TASK_SIZE 64
+
+// profiling region ids
+#define PROF_LOAD    0
+#define PROF_COMPUTE 1
+#define PROF_STORE   2
+
+typedef struct {
+  uint32_t num_tasks;
+  uint32_t task_size;
+  uint64_t src0_addr;
+  uint64_t src1_addr;
+  uint64_t dst_addr;
+} kernel_arg_t;
+
+#endif
@@ -0,0 +1,42 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include <vx_prof.h>
+#include "common.h"
+
+void kernel_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto src0_ptr = reinterpret_cast<int32_t*>(arg->src0_addr);
+	auto src1_ptr = reinterpret_cast<int32_t*>(arg->src1_addr);
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+
+	int32_t a[MAX_TASK_SIZE];
+	int32_t b[MAX_TASK_SIZE];
+
+	uint32_t count = arg->task_size;
+	uint32_t offset = task_id * count;
+
+	vx_prof_begin(PROF_LOAD);
+	for (uint32_t i = 0; i < count; ++i) {
+		a[i] = src0_ptr[offset+i];
+		b[i] = src1_ptr[offset+i];
+	}
+	vx_prof_end(PROF_LOAD);
+
+	vx_prof_begin(PROF_COMPUTE);
+	for (uint32_t i = 0; i < count; ++i) {
+		a[i] = a[i] * b[i] + (a[i] ^ b[i]);
+	}
+	vx_prof_end(PROF_COMPUTE);
+
+	vx_prof_begin(PROF_STORE);
+	for (uint32_t i = 0; i < count; ++i) {
+		dst_ptr[offset+i] = a[i];
+	}
+	vx_prof_end(PROF_STORE);
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	vx_spawn_tasks(arg->num_tasks, (vx_spawn_tasks_cb)kernel_body, arg);
+	return 0;
+}
@@ -0,0 +1,313 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <vortex.h>
+#include <cmath>
+#include "common.h"
+
+#define FLOAT_ULP 6
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename Type>
+class Comparator {};
+
+template <>
+class Comparator<int> {
+public:
+  static const char* type_str() {
+    return "integer";
+  }
+  static int generate() {
+    return rand();
+  }
+  static bool compare(int a, int b, int index, int errors) {
+    if (a != b) {
+      if (errors < 100) {
+        printf("*** error: [%d] expected=%d, actual=%d\n", index, b, a);
+      }
+      return false;
+    }
+    return true;
+  }
+};
+
+template <>
+class Comparator<float> {
+public:
+  static const char* type_str() {
+    return "float";
+  }
+  static int generate() {
+    return static_cast<float>(rand()) / RAND_MAX;
+  }
+  static bool compare(float a, float b, int index, int errors) {
+    union fi_t { float f; int32_t i; };
+    fi_t fa, fb;
+    fa.f = a;
+    fb.f = b;
+    auto d = std::abs(fa.i - fb.i);
+    if (d > FLOAT_ULP) {
+      if (errors < 100) {
+        printf("*** error: [%d] expected=%f, actual=%f\n", index, b, a);
+      }
+      return false;
+    }
+    return true;
+  }
+};
+
+static void matmul_cpu(TYPE* out, const TYPE* A, const TYPE* B, uint32_t width, uint32_t height) {
+  for (uint32_t row = 0; row < height; ++row) {
+    for (uint32_t col = 0; col < width; ++col) {
+      TYPE sum(0);
+      for (uint32_t e = 0; e < width; ++e) {
+          sum += A[row * width + e] * B[e * width + col];
+      }
+      out[row * width + col] = sum;
+    }
+  }
+}
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t size = 32;
+uint32_t max_devices = 0;
+
+struct device_ctx_t {
+  vx_device_h device = nullptr;
+  vx_buffer_h A_buffer = nullptr;
+  vx_buffer_h B_buffer = nullptr;
+  vx_buffer_h C_buffer = nullptr;
+  vx_buffer_h krnl_buffer = nullptr;
+  vx_buffer_h args_buffer = nullptr;
+  uint32_t row_offset = 0;
+  uint32_t num_rows = 0;
+};
+
+std::vector<device_ctx_t> devices;
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n size] [-d max devices] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:d:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      size = atoi(optarg);
+      break;
+    case 'd':
+      max_devices = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+static void release_buffers(device_ctx_t& ctx) {
+  vx_mem_free(ctx.A_buffer);
+  vx_mem_free(ctx.B_buffer);
+  vx_mem_free(ctx.C_buffer);
+  vx_mem_free(ctx.args_buffer);
+  ctx.A_buffer = nullptr;
+  ctx.B_buffer = nullptr;
+  ctx.C_buffer = nullptr;
+  ctx.args_buffer = nullptr;
+}
+
+void cleanup() {
+  for (auto& ctx : devices) {
+    if (ctx.device) {
+      release_buffers(ctx);
+      vx_mem_free(ctx.krnl_buffer);
+      vx_dev_close(ctx.device);
+    }
+  }
+  devices.clear();
+}
+
+// split the rows of C across the first num_devices devices and run them concurrently
+static double run_sgemm(uint32_t num_devices,
+                        const std::vector<TYPE>& h_A,
+                        const std::vector<TYPE>& h_B,
+                        std::vector<TYPE>& h_C) {
+  uint32_t rows_per_device = size / num_devices;
+  uint32_t remaining_rows = size - rows_per_device * num_devices;
+
+  uint32_t row_offset = 0;
+  for (uint32_t d = 0; d < num_devices; ++d) {
+    auto& ctx = devices.at(d);
+    ctx.row_offset = row_offset;
+    ctx.num_rows = rows_per_device + (d < remaining_rows);
+    row_offset += ctx.num_rows;
+    if (ctx.num_rows == 0)
+      continue;
+
+    uint32_t slice_size = ctx.num_rows * size * sizeof(TYPE);
+    uint32_t B_size = size * size * sizeof(TYPE);
+
+    kernel_arg_t kernel_arg = {};
+    kernel_arg.num_tasks = ctx.num_rows * size;
+    kernel_arg.size = size;
+    kernel_arg.log2_size = log2(size);
+
+    RT_CHECK(vx_mem_alloc(ctx.device, slice_size, VX_MEM_READ, &ctx.A_buffer));
+    RT_CHECK(vx_mem_address(ctx.A_buffer, &kernel_arg.A_addr));
+    RT_CHECK(vx_mem_alloc(ctx.device, B_size, VX_MEM_READ, &ctx.B_buffer));
+    RT_CHECK(vx_mem_address(ctx.B_buffer, &kernel_arg.B_addr));
+    RT_CHECK(vx_mem_alloc(ctx.device, slice_size, VX_MEM_WRITE, &ctx.C_buffer));
+    RT_CHECK(vx_mem_address(ctx.C_buffer, &kernel_arg.C_addr));
+
+    RT_CHECK(vx_copy_to_dev(ctx.A_buffer, h_A.data() + ctx.row_offset * size, 0, slice_size));
+    RT_CHECK(vx_copy_to_dev(ctx.B_buffer, h_B.data(), 0, B_size));
+    RT_CHECK(vx_upload_bytes(ctx.device, &kernel_arg, sizeof(kernel_arg_t), &ctx.args_buffer));
+  }
+
+  auto time_start = std::chrono::high_resolution_clock::now();
+
+  // start all devices
+  for (uint32_t d = 0; d < num_devices; ++d) {
+    auto& ctx = devices.at(d);
+    if (ctx.num_rows == 0)
+      continue;
+    RT_CHECK(vx_start(ctx.device, ctx.krnl_buffer, ctx.args_buffer));
+  }
+
+  // wait for completion
+  for (uint32_t d = 0; d < num_devices; ++d) {
+    auto& ctx = devices.at(d);
+    if (ctx.num_rows == 0)
+      continue;
+    RT_CHECK(vx_ready_wait(ctx.device, VX_MAX_TIMEOUT));
+  }
+
+  auto time_end = std::chrono::high_resolution_clock::now();
+  double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(time_end - time_start).count();
+
+  // download destination slices
+  for (uint32_t d = 0; d < num_devices; ++d) {
+    auto& ctx = devices.at(d);
+    if (ctx.num_rows == 0)
+      continue;
+    uint32_t slice_size = ctx.num_rows * size * sizeof(TYPE);
+    RT_CHECK(vx_copy_from_dev(h_C.data() + ctx.row_offset * size, ctx.C_buffer, 0, slice_size));
+    release_buffers(ctx);
+  }
+
+  return elapsed;
+}
+
+static int verify(const std::vector<TYPE>& h_C, const std::vector<TYPE>& h_ref) {
+  int errors = 0;
+  for (uint32_t i = 0; i < h_ref.size(); ++i) {
+    if (!Comparator<TYPE>::compare(h_C[i], h_ref[i], i, errors)) {
+      ++errors;
+    }
+  }
+  return errors;
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  std::srand(50);
+
+  // enumerate devices
+  uint32_t num_devices;
+  RT_CHECK(vx_dev_count(&num_devices));
+  if (max_devices != 0 && max_devices < num_devices) {
+    num_devices = max_devices;
+  }
+  if (num_devices == 0) {
+    std::cout << "no device found!" << std::endl;
+    return -1;
+  }
+  std::cout << "number of devices: " << num_devices << std::endl;
+
+  // open device connections
+  std::cout << "open device connections" << std::endl;
+  devices.resize(num_devices);
+  for (uint32_t d = 0; d < num_devices; ++d) {
+    auto& ctx = devices.at(d);
+    RT_CHECK(vx_dev_open_index(d, &ctx.device));
+    RT_CHECK(vx_upload_kernel_file(ctx.device, kernel_file, &ctx.krnl_buffer));
+  }
+
+  uint32_t size_sq = size * size;
+
+  std::cout << "data type: " << Comparator<TYPE>::type_str() << std::endl;
+  std::cout << "matrix size: " << size << "x" << size << std::endl;
+
+  // generate source data
+  std::vector<TYPE> h_A(size_sq);
+  std::vector<TYPE> h_B(size_sq);
+  std::vector<TYPE> h_C(size_sq);
+  for (uint32_t i = 0; i < size_sq; ++i) {
+    h_A[i] = Comparator<TYPE>::generate();
+    h_B[i] = Comparator<TYPE>::generate();
+  }
+
+  std::vector<TYPE> h_ref(size_sq);
+  matmul_cpu(h_ref.data(), h_A.data(), h_B.data(), size, size);
+
+  int errors = 0;
+
+  // single device baseline
+  std::cout << "run on 1 device" << std::endl;
+  double elapsed_single = run_sgemm(1, h_A, h_B, h_C);
+  errors += verify(h_C, h_ref);
+
+  // all devices
+  std::cout << "run on " << num_devices << " devices" << std::endl;
+  std::fill(h_C.begin(), h_C.end(), TYPE(0));
+  double elapsed_multi = run_sgemm(num_devices, h_A, h_B, h_C);
+  errors += verify(h_C, h_ref);
+
+  double flops = 2.0 * size * size * size;
+  printf("Elapsed time (1 device): %lg ms\n", elapsed_single);
+  printf("Elapsed time (%d devices): %lg ms\n", num_devices, elapsed_multi);
+  if (elapsed_single > 0 && elapsed_multi > 0) {
+    printf("Throughput: %lg -> %lg MFLOPS, speedup=%.2fx\n",
+      flops / (elapsed_single * 1000), flops / (elapsed_multi * 1000), elapsed_single / elapsed_multi);
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return errors;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,23 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#define LOCK_SPIN  0
+#define LOCK_SLEEP 1
+#define LOCK_WAIT  2
+
+// sleep backoff bounds, in cycles
+#define MIN_BACKOFF 16
+#define MAX_BACKOFF 1024
+
+// the shared words start on their own cache line
+#define SHARED_OFFSET 16
+
+typedef struct {
+  uint32_t mode;
+  uint32_t num_tasks;
+  uint32_t hold_words;
+  uint64_t state_addr;
+  uint64_t dst_addr;
+} kernel_arg_t;
+
+#endif
@@ -0,0 +1,39 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include "common.h"
+
+// every task increments all the shared words under a single lock,
+// waiting for it by polling, by sleeping with backoff, or by parking
+void kernel_body(int task_id, kernel_arg_t* __UNIFORM__ arg) {
+	auto state_ptr = reinterpret_cast<volatile int32_t*>(arg->state_addr);
+	auto lock = state_ptr;
+	auto shared = state_ptr + SHARED_OFFSET;
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	uint32_t delay = MIN_BACKOFF;
+	int32_t attempts = 0;
+
+	for (int done = 0; !done;) {
+		++attempts;
+		if (vx_lock_try(lock)) {
+			for (uint32_t i = 0; i < arg->hold_words; ++i) {
+				shared[i] = shared[i] + 1;
+			}
+			vx_lock_release(lock);
+			done = 1;
+		} else if (arg->mode == LOCK_SLEEP) {
+			vx_sleep(delay);
+			delay = (delay < MAX_BACKOFF) ? (delay * 2) : MAX_BACKOFF;
+		} else if (arg->mode == LOCK_WAIT) {
+			vx_lock_wait(lock);
+		}
+	}
+
+	dst_ptr[task_id] = attempts;
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	vx_spawn_tasks(arg->num_tasks, (vx_spawn_tasks_cb)kernel_body, arg);
+	return 0;
+}
@@ -0,0 +1,178 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <vortex.h>
+#include <VX_types.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t num_tasks = 64;
+uint32_t hold_words = 4;
+
+vx_device_h device = nullptr;
+vx_buffer_h state_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n tasks] [-w words updated under the lock] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:w:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      num_tasks = atoi(optarg);
+      break;
+    case 'w':
+      hold_words = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(state_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint64_t num_cores;
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_CORES, &num_cores));
+
+  uint32_t state_size = (SHARED_OFFSET + hold_words) * sizeof(int32_t);
+  uint32_t dst_buf_size = num_tasks * sizeof(int32_t);
+
+  std::cout << "number of tasks: " << num_tasks << std::endl;
+  std::cout << "words updated under the lock: " << hold_words << std::endl;
+
+  kernel_arg.num_tasks = num_tasks;
+  kernel_arg.hold_words = hold_words;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, state_size, VX_MEM_READ_WRITE, &state_buffer));
+  RT_CHECK(vx_mem_address(state_buffer, &kernel_arg.state_addr));
+  RT_CHECK(vx_mem_alloc(device, dst_buf_size, VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  std::vector<int32_t> h_state(SHARED_OFFSET + hold_words);
+  std::vector<int32_t> h_dst(num_tasks);
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  RT_CHECK(vx_mem_alloc(device, sizeof(kernel_arg_t), VX_MEM_READ, &args_buffer));
+
+  static const char* mode_names[] = {"spin", "sleep", "wait"};
+
+  int errors = 0;
+  uint64_t cycles[3], instrs[3], attempts[3];
+
+  for (uint32_t mode = LOCK_SPIN; mode <= LOCK_WAIT; ++mode) {
+    std::cout << "run " << mode_names[mode] << std::endl;
+
+    std::fill(h_state.begin(), h_state.end(), 0);
+    RT_CHECK(vx_copy_to_dev(state_buffer, h_state.data(), 0, state_size));
+
+    kernel_arg.mode = mode;
+    RT_CHECK(vx_copy_to_dev(args_buffer, &kernel_arg, 0, sizeof(kernel_arg_t)));
+
+    RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+    RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+    // issued instructions stand for issue slots, lock attempts for lock traffic
+    cycles[mode] = 0;
+    instrs[mode] = 0;
+    for (uint32_t core_id = 0; core_id < num_cores; ++core_id) {
+      uint64_t core_cycles, core_instrs;
+      RT_CHECK(vx_mpm_query(device, VX_CSR_MCYCLE, core_id, &core_cycles));
+      RT_CHECK(vx_mpm_query(device, VX_CSR_MINSTRET, core_id, &core_instrs));
+      cycles[mode] = std::max(cycles[mode], core_cycles);
+      instrs[mode] += core_instrs;
+    }
+
+    // verify result
+    RT_CHECK(vx_copy_from_dev(h_state.data(), state_buffer, 0, state_size));
+    RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, dst_buf_size));
+    if (h_state[0] != 0) {
+      printf("*** error: %s lock left held\n", mode_names[mode]);
+      ++errors;
+    }
+    for (uint32_t i = 0; i < hold_words; ++i) {
+      int32_t value = h_state[SHARED_OFFSET + i];
+      if (value != (int32_t)num_tasks) {
+        if (errors < 100) {
+          printf("*** error: %s [%d] expected=%d, actual=%d\n", mode_names[mode], i, num_tasks, value);
+        }
+        ++errors;
+      }
+    }
+    attempts[mode] = 0;
+    for (uint32_t i = 0; i < num_tasks; ++i) {
+      attempts[mode] += h_dst[i];
+    }
+  }
+
+  for (uint32_t mode = LOCK_SPIN; mode <= LOCK_WAIT; ++mode) {
+    std::cout << mode_names[mode] << ": " << cycles[mode] << " cycles, "
+              << instrs[mode] << " instructions, "
+              << attempts[mode] << " lock attempts" << std::endl;
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+#define REDUCE_LMEM 0
+#define REDUCE_WARP 1
+#define SCAN_LMEM   2
+#define SCAN_WARP   3
+
+typedef struct {
+  uint32_t mode;
+  uint32_t num_points;
+  uint32_t grid_dim;
+  uint32_t block_dim;
+  uint64_t src_addr;
+  uint64_t dst_addr;
+} kernel_arg_t;
+
+#endif
@@ -0,0 +1,120 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_spawn.h>
+#include "common.h"
+
+// block-wide reduction, one output per block
+void reduce_lmem(kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<int32_t*>(arg->src_addr);
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	auto local_ptr = reinterpret_cast<int32_t*>(vx_local_mem());
+	uint32_t lid = threadIdx.x;
+
+	local_ptr[lid] = src_ptr[globalIdx.x];
+	__syncthreads();
+
+	for (uint32_t s = blockDim.x / 2; s > 0; s >>= 1) {
+		if (lid < s) {
+			local_ptr[lid] += local_ptr[lid + s];
+		}
+		__syncthreads();
+	}
+
+	if (lid == 0) {
+		dst_ptr[blockIdx.x] = local_ptr[0];
+	}
+}
+
+void reduce_warp(kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<int32_t*>(arg->src_addr);
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	auto local_ptr = reinterpret_cast<int32_t*>(vx_local_mem());
+	uint32_t num_threads = vx_num_threads();
+	uint32_t num_warps = blockDim.x / num_threads;
+	uint32_t lane = threadIdx.x % num_threads;
+	uint32_t warp = threadIdx.x / num_threads;
+
+	// reduce each warp, then the per-warp partials on warp0
+	int32_t sum = vx_reduce_add(src_ptr[globalIdx.x]);
+	if (lane == 0) {
+		local_ptr[warp] = sum;
+	}
+	__syncthreads();
+
+	if (warp == 0) {
+		int32_t partial = (lane < num_warps) ? local_ptr[lane] : 0;
+		sum = vx_reduce_add(partial);
+		if (lane == 0) {
+			dst_ptr[blockIdx.x] = sum;
+		}
+	}
+
+	// keep the next block on this slot from overwriting the partials early
+	__syncthreads();
+}
+
+// block-wide inclusive prefix sum
+void scan_lmem(kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<int32_t*>(arg->src_addr);
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	auto local_ptr = reinterpret_cast<int32_t*>(vx_local_mem());
+	uint32_t lid = threadIdx.x;
+
+	local_ptr[lid] = src_ptr[globalIdx.x];
+	__syncthreads();
+
+	for (uint32_t offset = 1; offset < blockDim.x; offset <<= 1) {
+		int32_t value = (lid >= offset) ? local_ptr[lid - offset] : 0;
+		__syncthreads();
+		local_ptr[lid] += value;
+		__syncthreads();
+	}
+
+	dst_ptr[globalIdx.x] = local_ptr[lid];
+	__syncthreads();
+}
+
+void scan_warp(kernel_arg_t* __UNIFORM__ arg) {
+	auto src_ptr = reinterpret_cast<int32_t*>(arg->src_addr);
+	auto dst_ptr = reinterpret_cast<int32_t*>(arg->dst_addr);
+	auto local_ptr = reinterpret_cast<int32_t*>(vx_local_mem());
+	uint32_t num_threads = vx_num_threads();
+	uint32_t num_warps = blockDim.x / num_threads;
+	uint32_t lane = threadIdx.x % num_threads;
+	uint32_t warp = threadIdx.x / num_threads;
+
+	// scan each warp, then scan the warp totals on warp0
+	int32_t value = vx_scan_add(src_ptr[globalIdx.x]);
+	if (lane == num_threads - 1) {
+		local_ptr[warp] = value;
+	}
+	__syncthreads();
+
+	if (warp == 0) {
+		int32_t total = (lane < num_warps) ? local_ptr[lane] : 0;
+		total = vx_scan_add(total);
+		if (lane < num_warps) {
+			local_ptr[lane] = total;
+		}
+	}
+	__syncthreads();
+
+	if (warp != 0) {
+		value += local_ptr[warp - 1];
+	}
+	dst_ptr[globalIdx.x] = value;
+	__syncthreads();
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	uint32_t local_size = arg->block_dim * sizeof(int32_t);
+	vx_spawn_threads_cb kernels[] = {
+		(vx_spawn_threads_cb)reduce_lmem,
+		(vx_spawn_threads_cb)reduce_warp,
+		(vx_spawn_threads_cb)scan_lmem,
+		(vx_spawn_threads_cb)scan_warp
+	};
+	vx_spawn_threads(1, &arg->grid_dim, &arg->block_dim, local_size, kernels[arg->mode], arg);
+	return 0;
+}
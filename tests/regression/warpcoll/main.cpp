@@ -0,0 +1,191 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <vortex.h>
+#include <VX_types.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t size = 4096;
+
+vx_device_h device = nullptr;
+vx_buffer_h src_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n words] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:k:h?")) != -1) {
+    switch (c) {
+    case 'n':
+      size = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+    case '?': {
+      show_usage();
+      exit(0);
+    } break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    vx_mem_free(src_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  uint64_t num_cores, num_threads;
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_CORES, &num_cores));
+  RT_CHECK(vx_dev_caps(device, VX_CAPS_NUM_THREADS, &num_threads));
+
+  // whole warps per block, and few enough warps for a single combining pass
+  uint32_t block_dim;
+  RT_CHECK(vx_pick_block_dim(device, 1, &size, sizeof(int32_t), &block_dim));
+  if ((block_dim % num_threads) != 0 || (block_dim / num_threads) > num_threads) {
+    std::cout << "Error: unsupported block size " << block_dim << std::endl;
+    cleanup();
+    return -1;
+  }
+  uint32_t num_blocks = size / block_dim;
+  uint32_t buf_size = size * sizeof(int32_t);
+
+  std::cout << "number of points: " << size << std::endl;
+  std::cout << "block size: " << block_dim << std::endl;
+
+  kernel_arg.num_points = size;
+  kernel_arg.grid_dim = num_blocks;
+  kernel_arg.block_dim = block_dim;
+
+  // allocate device memory
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ, &src_buffer));
+  RT_CHECK(vx_mem_address(src_buffer, &kernel_arg.src_addr));
+  RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  std::vector<int32_t> h_src(size);
+  std::vector<int32_t> h_dst(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    h_src[i] = (std::rand() % 200) - 100;
+  }
+
+  // per-block references
+  std::vector<int32_t> h_sums(num_blocks);
+  std::vector<int32_t> h_scan(size);
+  for (uint32_t b = 0; b < num_blocks; ++b) {
+    int32_t acc = 0;
+    for (uint32_t i = 0; i < block_dim; ++i) {
+      acc += h_src[b * block_dim + i];
+      h_scan[b * block_dim + i] = acc;
+    }
+    h_sums[b] = acc;
+  }
+
+  std::cout << "upload source buffer" << std::endl;
+  RT_CHECK(vx_copy_to_dev(src_buffer, h_src.data(), 0, buf_size));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  RT_CHECK(vx_mem_alloc(device, sizeof(kernel_arg_t), VX_MEM_READ, &args_buffer));
+
+  static const char* mode_names[] = {"reduce (local memory)", "reduce (warp)", "scan (local memory)", "scan (warp)"};
+
+  int errors = 0;
+  uint64_t cycles[4];
+
+  for (uint32_t mode = REDUCE_LMEM; mode <= SCAN_WARP; ++mode) {
+    std::cout << "run " << mode_names[mode] << std::endl;
+
+    std::fill(h_dst.begin(), h_dst.end(), 0);
+    RT_CHECK(vx_copy_to_dev(dst_buffer, h_dst.data(), 0, buf_size));
+
+    kernel_arg.mode = mode;
+    RT_CHECK(vx_copy_to_dev(args_buffer, &kernel_arg, 0, sizeof(kernel_arg_t)));
+
+    RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+    RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+    cycles[mode] = 0;
+    for (uint32_t core_id = 0; core_id < num_cores; ++core_id) {
+      uint64_t core_cycles;
+      RT_CHECK(vx_mpm_query(device, VX_CSR_MCYCLE, core_id, &core_cycles));
+      cycles[mode] = std::max(cycles[mode], core_cycles);
+    }
+
+    // verify result
+    RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, buf_size));
+    bool is_scan = (mode == SCAN_LMEM || mode == SCAN_WARP);
+    uint32_t count = is_scan ? size : num_blocks;
+    for (uint32_t i = 0; i < count; ++i) {
+      int32_t ref = is_scan ? h_scan[i] : h_sums[i];
+      if (h_dst[i] != ref) {
+        if (errors < 100) {
+          printf("*** error: %s [%d] expected=%d, actual=%d\n", mode_names[mode], i, ref, h_dst[i]);
+        }
+        ++errors;
+      }
+    }
+  }
+
+  for (uint32_t mode = REDUCE_LMEM; mode <= SCAN_WARP; ++mode) {
+    std::cout << mode_names[mode] << ": " << cycles[mode] << " cycles" << std::endl;
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}